@@ -0,0 +1,209 @@
+/**
+ * @file load.cpp
+ * @brief Load benchmark for GitHubClient against the local API stand-in
+ *
+ * Usage: load_gh_repo [--repos N[,N...]] [--latency MS] [--jitter MS]
+ *                     [--errors RATE] [--ops N] [--transport httplib|curl]
+ *
+ * For each account size and transport backend, measures throughput and
+ * p50/p99 latency of full listings (GraphQL and REST) and of concurrent
+ * creates and deletes. The
+ * stand-in runs in-process on loopback, so results isolate client cost plus
+ * the configured server latency.
+ */
+
+#include "github.h"
+#include "mock_server.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Config {
+    std::vector<size_t> sizes = {100, 1000, 10000, 100000};
+    std::chrono::milliseconds latency{0};
+    std::chrono::milliseconds jitter{0};
+    double errorRate = 0.0;
+    size_t ops = 200;
+    std::vector<TransportKind> transports = availableTransports();
+};
+
+struct Stats {
+    size_t ops = 0;
+    size_t failed = 0;
+    double throughput = 0;  // units per second
+    double p50Ms = 0;
+    double p99Ms = 0;
+};
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Summarizes per-operation latencies measured over a wall-clock span
+ * @param units Work done in the span (operations, or repositories for listings)
+ */
+Stats summarize(std::vector<double> latencies, size_t failed, double totalMs, double units) {
+    Stats stats;
+    stats.ops = latencies.size();
+    stats.failed = failed;
+    stats.throughput = totalMs > 0 ? units * 1000.0 / totalMs : 0;
+    if (!latencies.empty()) {
+        std::sort(latencies.begin(), latencies.end());
+        stats.p50Ms = latencies[latencies.size() / 2];
+        stats.p99Ms = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+    }
+    return stats;
+}
+
+void printRow(const std::string& label, const Stats& s, const std::string& unit) {
+    std::cout << "  " << std::left << std::setw(16) << label << std::right
+              << std::setw(7) << s.ops << std::setw(8) << s.failed
+              << std::setw(12) << std::fixed << std::setprecision(1) << s.throughput << " " << std::left << std::setw(8) << unit
+              << std::right << std::setw(10) << std::setprecision(2) << s.p50Ms
+              << std::setw(10) << s.p99Ms << "\n";
+}
+
+/**
+ * @brief Full listings, one after another; throughput is reported in repos/s
+ */
+Stats benchList(GitHubClient& client, size_t expected, size_t iterations) {
+    std::vector<double> latencies;
+    size_t failed = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        auto opStart = Clock::now();
+        auto repos = client.listRepositories();
+        latencies.push_back(elapsedMs(opStart));
+        if (repos.size() != expected) failed++;
+    }
+    return summarize(std::move(latencies), failed, elapsedMs(start),
+                     static_cast<double>(expected * iterations));
+}
+
+/**
+ * @brief Runs fn(i) for every i concurrently through the async API
+ */
+template <typename Fn>
+Stats benchConcurrent(size_t ops, Fn&& fn) {
+    // Submit everything first, then collect, so calls overlap on the client's executor
+    std::vector<std::future<bool>> submitted;
+    std::vector<Clock::time_point> startedAt;
+    submitted.reserve(ops);
+    startedAt.reserve(ops);
+    auto start = Clock::now();
+    for (size_t i = 0; i < ops; i++) {
+        startedAt.push_back(Clock::now());
+        submitted.push_back(fn(i));
+    }
+
+    // Latency is measured from submission, so it includes time queued behind other calls
+    std::vector<double> latencies;
+    size_t failed = 0;
+    for (size_t i = 0; i < ops; i++) {
+        if (!submitted[i].get()) failed++;
+        latencies.push_back(elapsedMs(startedAt[i]));
+    }
+    return summarize(std::move(latencies), failed, elapsedMs(start), static_cast<double>(ops));
+}
+
+void run(const Config& config, size_t repoCount, TransportKind transport) {
+    mock::Options options;
+    options.repoCount = repoCount;
+    options.latency = config.latency;
+    options.jitter = config.jitter;
+    options.errorRate = config.errorRate;
+    options.threads = 64;
+    mock::GitHubServer server(options);
+
+    GitHubClient client(server.token(), server.baseUrl());
+    client.setTransport(transport);
+    client.setCacheEnabled(false);
+    client.setMutationInterval(std::chrono::milliseconds(0));
+    client.authenticate();
+
+    size_t iterations = repoCount >= 100000 ? 3 : repoCount >= 10000 ? 5 : 20;
+    std::cout << repoCount << " repositories, " << client.transportName() << " transport, latency " << config.latency.count() << " ms +"
+              << config.jitter.count() << " ms, error rate " << config.errorRate << "\n";
+    std::cout << "  " << std::left << std::setw(16) << "operation" << std::right << std::setw(7) << "ops"
+              << std::setw(8) << "failed" << std::setw(21) << "throughput"
+              << std::setw(10) << "p50 ms" << std::setw(10) << "p99 ms" << "\n";
+
+    printRow("list (GraphQL)", benchList(client, repoCount, iterations), "repos/s");
+    client.setGraphQLEnabled(false);
+    printRow("list (REST)", benchList(client, repoCount, iterations), "repos/s");
+
+    auto create = benchConcurrent(config.ops, [&](size_t i) {
+        RepoInfo repo;
+        repo.name = "load-" + std::to_string(i);
+        return client.createRepositoryAsync(repo);
+    });
+    printRow("create", create, "ops/s");
+
+    auto remove = benchConcurrent(config.ops, [&](size_t i) {
+        return client.deleteRepositoryAsync("load-" + std::to_string(i));
+    });
+    printRow("delete", remove, "ops/s");
+    std::cout << "  " << server.requests() << " requests served, " << server.injectedErrors()
+              << " injected errors\n\n";
+}
+
+std::vector<size_t> parseSizes(const std::string& list) {
+    std::vector<size_t> sizes;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) sizes.push_back(std::stoul(item));
+    }
+    return sizes;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Config config;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--repos") == 0 && i + 1 < argc) {
+            config.sizes = parseSizes(argv[++i]);
+        } else if (strcmp(argv[i], "--latency") == 0 && i + 1 < argc) {
+            config.latency = std::chrono::milliseconds(std::atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--jitter") == 0 && i + 1 < argc) {
+            config.jitter = std::chrono::milliseconds(std::atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--errors") == 0 && i + 1 < argc) {
+            config.errorRate = std::atof(argv[++i]);
+        } else if (strcmp(argv[i], "--ops") == 0 && i + 1 < argc) {
+            config.ops = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (strcmp(argv[i], "--transport") == 0 && i + 1 < argc) {
+            auto kind = parseTransportKind(argv[++i]);
+            auto built = availableTransports();
+            if (!kind || std::find(built.begin(), built.end(), *kind) == built.end()) {
+                std::cerr << "Transport not available: " << argv[i] << "\n";
+                return 1;
+            }
+            config.transports = {*kind};
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--repos N[,N...]] [--latency MS] [--jitter MS] [--errors RATE] [--ops N]"
+                         " [--transport httplib|curl]\n";
+            return 1;
+        }
+    }
+
+    for (size_t size : config.sizes) {
+        for (TransportKind transport : config.transports) {
+            run(config, size, transport);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,427 @@
+/**
+ * @file main.cpp
+ * @brief Benchmarks for gh-repo hot paths
+ *
+ * Usage: bench_gh_repo [benchmark]
+ *
+ * Runs every benchmark when no name is given. Heap usage is measured by
+ * replacing the global allocation functions with counting versions.
+ */
+
+#include "git_repo.h"
+#include "github.h"
+#include "repo_list.h"
+#include "repo_parser.h"
+#include "repo_search.h"
+#include "fixtures.h"
+#include "mock_server.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+#include <zlib.h>
+#endif
+
+// ============================================================================
+// Heap Accounting
+// ============================================================================
+
+namespace {
+
+std::atomic<size_t> g_currentBytes{0};
+std::atomic<size_t> g_peakBytes{0};
+
+// Allocations carry a small header recording their size
+constexpr size_t HEADER_SIZE = alignof(std::max_align_t);
+
+void* countedAlloc(size_t size) {
+    void* raw = std::malloc(size + HEADER_SIZE);
+    if (!raw) throw std::bad_alloc();
+    *static_cast<size_t*>(raw) = size;
+    size_t current = g_currentBytes.fetch_add(size) + size;
+    size_t peak = g_peakBytes.load();
+    while (current > peak && !g_peakBytes.compare_exchange_weak(peak, current)) {}
+    return static_cast<char*>(raw) + HEADER_SIZE;
+}
+
+void countedFree(void* ptr) {
+    if (!ptr) return;
+    void* raw = static_cast<char*>(ptr) - HEADER_SIZE;
+    g_currentBytes.fetch_sub(*static_cast<size_t*>(raw));
+    std::free(raw);
+}
+
+/**
+ * @brief Resets the peak so the next measurement starts from the current usage
+ */
+size_t resetPeak() {
+    size_t current = g_currentBytes.load();
+    g_peakBytes.store(current);
+    return current;
+}
+
+}  // namespace
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void operator delete(void* ptr) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { countedFree(ptr); }
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Measurement {
+    double medianMs;
+    size_t peakBytes;
+};
+
+/**
+ * @brief Runs fn repeatedly and reports the median time and the peak heap growth
+ */
+template <typename Fn>
+Measurement measure(int iterations, Fn&& fn) {
+    std::vector<double> times;
+    size_t peak = 0;
+    for (int i = 0; i < iterations; i++) {
+        size_t base = resetPeak();
+        auto start = Clock::now();
+        fn();
+        auto end = Clock::now();
+        peak = std::max(peak, g_peakBytes.load() - base);
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return {times[times.size() / 2], peak};
+}
+
+void printRow(const std::string& label, const Measurement& m) {
+    std::cout << "  " << std::left << std::setw(22) << label << std::right
+              << std::setw(10) << std::fixed << std::setprecision(3) << m.medianMs << " ms"
+              << std::setw(12) << (m.peakBytes / 1024) << " KiB peak\n";
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+/**
+ * @brief Decoding one page of /user/repos: DOM versus streaming SAX
+ */
+void benchParse() {
+    const int iterations = 50;
+    std::string page = fixtures::repoPageJson("octocat", 1, 100);
+    std::cout << "parse: one page of 100 repositories (" << page.size() / 1024 << " KiB)\n";
+
+    auto dom = measure(iterations, [&]() {
+        std::vector<RepoInfo> repos;
+        parseRepoPageDom(page, repos);
+    });
+    auto sax = measure(iterations, [&]() {
+        std::vector<RepoInfo> repos;
+        parseRepoPage(page, repos);
+    });
+    printRow("DOM (nlohmann::json)", dom);
+    printRow("SAX (streaming)", sax);
+    std::cout << "  speedup " << std::setprecision(1) << dom.medianMs / sax.medianMs << "x, peak memory "
+              << static_cast<double>(dom.peakBytes) / static_cast<double>(std::max<size_t>(sax.peakBytes, 1))
+              << "x smaller\n\n";
+}
+
+/**
+ * @brief Listing one page of 100 repositories: REST versus projected GraphQL
+ */
+void benchGraphQL() {
+    const int iterations = 50;
+    std::string rest = fixtures::repoPageJson("octocat", 1, 100);
+    std::string graphql = fixtures::graphqlPageJson("octocat", 1, 100, true);
+    std::cout << "graphql: one page of 100 repositories, REST " << rest.size() / 1024
+              << " KiB vs GraphQL " << graphql.size() / 1024 << " KiB ("
+              << std::setprecision(1) << std::fixed
+              << static_cast<double>(rest.size()) / static_cast<double>(graphql.size()) << "x fewer bytes)\n";
+
+    auto restParse = measure(iterations, [&]() {
+        std::vector<RepoInfo> repos;
+        parseRepoPage(rest, repos);
+    });
+    auto graphqlParse = measure(iterations, [&]() {
+        std::vector<RepoInfo> repos;
+        GraphQLPageInfo page;
+        parseGraphQLRepoPage(graphql, repos, page);
+    });
+    printRow("REST /user/repos", restParse);
+    printRow("GraphQL projection", graphqlParse);
+    std::cout << "  parse speedup " << std::setprecision(1) << restParse.medianMs / graphqlParse.medianMs << "x\n\n";
+}
+
+/**
+ * @brief Holding an org-scale listing: a RepoInfo per repository versus RepoList
+ */
+void benchMemory() {
+    const int count = 50000;
+    const int perPage = 100;
+    std::vector<std::string> pages;
+    for (int first = 1; first <= count; first += perPage) {
+        pages.push_back(fixtures::graphqlPageJson("octo-org", first, perPage, first + perPage <= count));
+    }
+    std::cout << "memory: " << count << " repositories decoded from " << pages.size() << " GraphQL pages\n";
+
+    size_t base = g_currentBytes.load();
+    std::vector<RepoInfo> vector;
+    for (const auto& page : pages) {
+        GraphQLPageInfo info;
+        parseGraphQLRepoPage(page, vector, info);
+    }
+    size_t vectorBytes = g_currentBytes.load() - base;
+
+    base = g_currentBytes.load();
+    RepoList list;
+    {
+        std::vector<RepoInfo> nodes;
+        for (const auto& page : pages) {
+            GraphQLPageInfo info;
+            nodes.clear();
+            parseGraphQLRepoPage(page, nodes, info);
+            list.append(nodes);
+        }
+    }
+    size_t listBytes = g_currentBytes.load() - base;
+
+    auto perRepo = [count](size_t bytes) { return static_cast<double>(bytes) / count; };
+    std::cout << "  " << std::left << std::setw(22) << "std::vector<RepoInfo>" << std::right << std::fixed
+              << std::setprecision(1) << std::setw(10) << perRepo(vectorBytes) << " bytes/repo"
+              << std::setw(10) << vectorBytes / 1024 << " KiB\n";
+    std::cout << "  " << std::left << std::setw(22) << "RepoList (arena)" << std::right
+              << std::setw(10) << perRepo(listBytes) << " bytes/repo"
+              << std::setw(10) << listBytes / 1024 << " KiB\n";
+    std::cout << "  " << static_cast<double>(vectorBytes) / static_cast<double>(std::max<size_t>(listBytes, 1))
+              << "x smaller\n\n";
+}
+
+/**
+ * @brief Ranked trigram search versus the linear name scan `list <filter>` used
+ */
+void benchSearch() {
+    const int count = 50000;
+    RepoList list;
+    {
+        std::vector<RepoInfo> nodes;
+        for (int first = 1; first <= count; first += 100) {
+            GraphQLPageInfo info;
+            nodes.clear();
+            parseGraphQLRepoPage(fixtures::graphqlPageJson("octo-org", first, 100, first + 100 <= count), nodes, info);
+            list.append(nodes);
+        }
+    }
+    std::cout << "search: " << count << " repositories\n";
+
+    RepoSearch search;
+    auto build = measure(5, [&]() { search.build(list); });
+    printRow("build", build);
+    std::cout << "  index holds " << search.memoryUsage() / 1024 << " KiB\n";
+
+    // Baseline: the case-insensitive substring scan over every name that `list <filter>` did
+    const int iterations = 200;
+    auto scan = measure(iterations, [&]() {
+        const std::string needle = "repo-4242";
+        std::vector<uint32_t> matches;
+        for (size_t i = 0; i < list.size(); i++) {
+            std::string_view name = list.name(i);
+            auto it = std::search(name.begin(), name.end(), needle.begin(), needle.end(), [](char a, char b) {
+                return std::tolower(static_cast<unsigned char>(a)) == b;
+            });
+            if (it != name.end()) matches.push_back(static_cast<uint32_t>(i));
+        }
+    });
+    printRow("linear scan", scan);
+
+    const std::pair<const char*, const char*> queries[] = {
+        {"exact", "repo-4242"},
+        {"prefix", "repo-424"},
+        {"typo", "rpeo-4242"},
+        {"description", "number 777"},
+        {"everything", "repo"},
+        {"two letters", "42"},
+    };
+    for (const auto& [label, query] : queries) {
+        size_t hits = 0;
+        auto m = measure(iterations, [&]() { hits = search.search(query, 20).size(); });
+        printRow(std::string(label) + " (" + std::to_string(hits) + ")", m);
+    }
+    std::cout << "\n";
+}
+
+/**
+ * @brief In-process repository reads versus the git subprocesses they replace
+ *
+ * Needs git on PATH to set up a scratch repository with one commit and an
+ * origin remote.
+ */
+void benchGit() {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "gh-repo-bench-git";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "src" / "deep");
+    std::string quoted = "\"" + dir.string() + "\"";
+    std::string setup = "git init -q " + quoted + " && git -C " + quoted +
+                        " -c user.name=bench -c user.email=bench@example.com commit -q --allow-empty -m init" +
+                        " && git -C " + quoted + " remote add origin git@github.com:octocat/bench.git";
+    if (std::system((setup + " > /dev/null 2>&1").c_str()) != 0) {
+        std::cout << "git: skipped (git is not available)\n\n";
+        return;
+    }
+    std::string path = (dir / "src" / "deep").string();
+    std::cout << "git: branch and origin URL of a repository two levels up\n";
+
+    auto native = measure(200, [&]() {
+        auto repo = GitRepo::discover(path);
+        if (!repo || !repo->head() || !repo->remoteUrl("origin")) std::cerr << "read failed\n";
+    });
+    printRow("GitRepo", native);
+
+    auto shell = measure(10, [&]() {
+        std::string cmd = "cd \"" + path + "\" && git rev-parse --git-dir && git rev-parse --abbrev-ref HEAD" +
+                          " && git remote get-url origin";
+        if (std::system(("{ " + cmd + "; } > /dev/null 2>&1").c_str()) != 0) std::cerr << "git failed\n";
+    });
+    printRow("git subprocesses", shell);
+    std::cout << "\n";
+    fs::remove_all(dir);
+}
+
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+/**
+ * @brief gzip-compresses data at zlib's default level, as GitHub's servers do
+ */
+std::string gzipCompress(const std::string& data) {
+    z_stream zs{};
+    deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    std::string out(deflateBound(&zs, static_cast<uLong>(data.size())), '\0');
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    zs.avail_in = static_cast<uInt>(data.size());
+    zs.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    zs.avail_out = static_cast<uInt>(out.size());
+    deflate(&zs, Z_FINISH);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    return out;
+}
+
+/**
+ * @brief Wall time of a full listing through GitHubClient, identity versus gzip
+ *
+ * Pages come from the API stand-in on loopback, so the time is the client's
+ * real cost: requests, the server compressing, inflating and decoding. A
+ * loopback transfer is nearly free, so the last columns add the bytes on
+ * the wire at a few link speeds as a projection.
+ */
+void benchGzip() {
+    const int iterations = 20;
+    const size_t repoCount = 1000;
+    const size_t pages = repoCount / 100;
+    const double linksMbit[] = {10, 100, 1000};
+
+    mock::Options options;
+    options.repoCount = repoCount;
+    mock::GitHubServer server(options);
+
+    struct Variant {
+        const char* label;
+        size_t pageBytes;  // On the wire, for the projection
+        bool compressed;
+        bool graphql;
+    };
+    std::string rest = fixtures::repoPageJson("octocat", 1, 100);
+    std::string graphql = fixtures::graphqlPageJson("octocat", 1, 100, true);
+    size_t restGzip = gzipCompress(rest).size();
+    Variant variants[] = {
+        {"REST identity", rest.size(), false, false},
+        {"REST gzip", restGzip, true, false},
+        {"GraphQL identity", graphql.size(), false, true},
+        {"GraphQL gzip", gzipCompress(graphql).size(), true, true},
+    };
+
+    std::cout << "gzip: listing " << repoCount << " repositories (" << pages
+              << " pages) from the local API stand-in\n";
+    std::cout << "  " << std::left << std::setw(18) << "" << std::right << std::setw(12) << "bytes/page"
+              << std::setw(12) << "wall ms";
+    for (double mbit : linksMbit) {
+        std::cout << std::setw(9) << static_cast<int>(mbit) << " Mb/s";
+    }
+    std::cout << "\n";
+
+    for (const auto& v : variants) {
+        GitHubClient client(server.token(), server.baseUrl());
+        client.setCacheEnabled(false);
+        client.setCompressionEnabled(v.compressed);
+        client.setGraphQLEnabled(v.graphql);
+        client.listRepositoriesCompact();  // Opens the connections
+        size_t listed = 0;
+        auto wall = measure(iterations, [&]() { listed = client.listRepositoriesCompact().size(); });
+        if (listed != repoCount) {
+            std::cerr << v.label << ": listed " << listed << " of " << repoCount << " repositories\n";
+        }
+
+        std::cout << "  " << std::left << std::setw(18) << v.label << std::right
+                  << std::setw(12) << v.pageBytes
+                  << std::setw(12) << std::fixed << std::setprecision(2) << wall.medianMs;
+        for (double mbit : linksMbit) {
+            double transferMs = static_cast<double>(v.pageBytes * pages) * 8.0 / (mbit * 1000.0);
+            std::cout << std::setw(11) << std::setprecision(1) << wall.medianMs + transferMs << " ms";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "  REST compression ratio " << std::setprecision(1)
+              << static_cast<double>(rest.size()) / static_cast<double>(restGzip) << ":1\n\n";
+}
+#endif
+
+struct Benchmark {
+    const char* name;
+    void (*run)();
+};
+
+const Benchmark BENCHMARKS[] = {
+    {"parse", benchParse},
+    {"graphql", benchGraphQL},
+    {"memory", benchMemory},
+    {"search", benchSearch},
+    {"git", benchGit},
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+    {"gzip", benchGzip},
+#endif
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string only = argc > 1 ? argv[1] : "";
+    bool ran = false;
+    for (const auto& bench : BENCHMARKS) {
+        if (only.empty() || only == bench.name) {
+            bench.run();
+            ran = true;
+        }
+    }
+    if (!ran) {
+        std::cerr << "Unknown benchmark: " << only << "\n";
+        return 1;
+    }
+    return 0;
+}
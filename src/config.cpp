@@ -1,16 +1,41 @@
 #include "config.h"
+#include "constants.h"
 #include <iostream>
 #include <fstream>
 #include <filesystem>
 #include <cstdlib>
 #include <nlohmann/json.hpp>
+#include <openssl/evp.h>
 
 using json = nlohmann::json;
 
+std::string sha256Hex(const std::string& data) {
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int length = 0;
+    EVP_Digest(data.data(), data.size(), digest, &length, EVP_sha256(), nullptr);
+    
+    static const char* hex = "0123456789abcdef";
+    std::string out;
+    out.reserve(length * 2);
+    for (unsigned int i = 0; i < length; i++) {
+        out += hex[digest[i] >> 4];
+        out += hex[digest[i] & 0x0f];
+    }
+    return out;
+}
+
 ConfigManager::ConfigManager() {
     configPath_ = getConfigPath();
 }
 
+std::string ConfigManager::dataDir() {
+    const char* home = std::getenv("HOME");
+    if (home) {
+        return std::string(home) + "/" + constants::DATA_DIR;
+    }
+    return constants::DATA_DIR;
+}
+
 std::string ConfigManager::getConfigPath() {
     std::string home = expandTilde("~/.gh-repo-create.json");
     return home;
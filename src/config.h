@@ -10,10 +10,14 @@ struct Config {
     std::string configPath;
 };
 
+std::string sha256Hex(const std::string& data);
+
 class ConfigManager {
 public:
     ConfigManager();
     
+    static std::string dataDir();
+    
     std::optional<std::string> loadToken();
     bool saveToken(const std::string& token);
     bool hasToken();
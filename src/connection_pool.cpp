@@ -0,0 +1,104 @@
+/**
+ * @file connection_pool.cpp
+ * @brief Keep-alive HTTP connection pool
+ *
+ * Reusing an httplib::Client across requests keeps its socket open, so only
+ * the first request on each connection pays for DNS, TCP and the TLS handshake.
+ */
+
+#include "connection_pool.h"
+#include <iostream>
+#include <httplib.h>
+
+// ============================================================================
+// Lease
+// ============================================================================
+
+ConnectionPool::Lease::Lease(ConnectionPool* pool, std::unique_ptr<httplib::Client> client, bool reused)
+    : pool_(pool), client_(std::move(client)), reused_(reused) {}
+
+ConnectionPool::Lease::Lease(Lease&& other) noexcept
+    : pool_(other.pool_), client_(std::move(other.client_)), reused_(other.reused_) {
+    other.pool_ = nullptr;
+}
+
+ConnectionPool::Lease::~Lease() {
+    if (pool_ && client_) {
+        pool_->release(std::move(client_));
+    }
+}
+
+// ============================================================================
+// Pool
+// ============================================================================
+
+ConnectionPool::ConnectionPool(const std::string& baseUrl, size_t maxIdle, Setup setup)
+    : baseUrl_(baseUrl), maxIdle_(maxIdle), setup_(std::move(setup)) {}
+
+ConnectionPool::~ConnectionPool() = default;
+
+/**
+ * @brief Hands out an idle client, or creates a new one if none is idle
+ * @return Lease that returns the client to the pool when destroyed
+ *
+ * A client counts as reused when its socket is still open from a previous
+ * request; httplib transparently reconnects if the server has since closed it.
+ */
+ConnectionPool::Lease ConnectionPool::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!idle_.empty()) {
+        auto client = std::move(idle_.back());
+        idle_.pop_back();
+        // A closed socket means the peer dropped the idle connection; the
+        // client object is still usable but the next request reconnects.
+        bool reused = client->is_socket_open() != 0;
+        if (reused) {
+            reused_++;
+        } else {
+            opened_++;
+        }
+        size_t idleLeft = idle_.size();
+        lock.unlock();
+        if (debug_) {
+            if (reused) {
+                std::cerr << "[DEBUG] Reusing keep-alive connection to " << baseUrl_
+                          << " (" << idleLeft << " idle)\n";
+            } else {
+                std::cerr << "[DEBUG] Idle connection to " << baseUrl_ << " was closed, reconnecting\n";
+            }
+        }
+        return Lease(this, std::move(client), reused);
+    }
+    opened_++;
+    lock.unlock();
+
+    auto client = std::make_unique<httplib::Client>(baseUrl_);
+    client->set_keep_alive(true);
+    if (setup_) {
+        setup_(*client);
+    }
+    if (debug_) {
+        std::cerr << "[DEBUG] Opening new connection to " << baseUrl_ << "\n";
+    }
+    return Lease(this, std::move(client), false);
+}
+
+/**
+ * @brief Returns a client to the idle list, dropping it if the pool is full
+ */
+void ConnectionPool::release(std::unique_ptr<httplib::Client> client) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (idle_.size() < maxIdle_) {
+        idle_.push_back(std::move(client));
+    }
+}
+
+size_t ConnectionPool::opened() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return opened_;
+}
+
+size_t ConnectionPool::reusedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reused_;
+}
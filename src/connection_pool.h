@@ -0,0 +1,69 @@
+#ifndef CONNECTION_POOL_H
+#define CONNECTION_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace httplib {
+class Client;
+}
+
+/**
+ * @brief Pool of keep-alive HTTP clients bound to a single host
+ *
+ * Each httplib::Client owns one socket, so a client handed back to the pool
+ * keeps its TCP/TLS session open for the next caller. Clients are handed out
+ * exclusively through a Lease and returned when the lease goes out of scope.
+ */
+class ConnectionPool {
+public:
+    class Lease {
+    public:
+        Lease(ConnectionPool* pool, std::unique_ptr<httplib::Client> client, bool reused);
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&&) = delete;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+        httplib::Client& client() { return *client_; }
+        httplib::Client* operator->() { return client_.get(); }
+        bool reused() const { return reused_; }
+
+    private:
+        ConnectionPool* pool_;
+        std::unique_ptr<httplib::Client> client_;
+        bool reused_;
+    };
+
+    using Setup = std::function<void(httplib::Client&)>;
+
+    ConnectionPool(const std::string& baseUrl, size_t maxIdle, Setup setup = nullptr);
+    ~ConnectionPool();
+
+    Lease acquire();
+    void setDebug(bool debug) { debug_ = debug; }
+
+    size_t opened() const;
+    size_t reusedCount() const;
+
+private:
+    void release(std::unique_ptr<httplib::Client> client);
+
+    std::string baseUrl_;
+    size_t maxIdle_;
+    Setup setup_;
+    std::atomic<bool> debug_{false};
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<httplib::Client>> idle_;
+    size_t opened_ = 0;
+    size_t reused_ = 0;
+};
+
+#endif
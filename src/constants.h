@@ -1,14 +1,29 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
+#include <cstddef>
 #include <string>
 
 namespace constants {
 
 // GitHub API
+constexpr const char* API_BASE_URL = "https://api.github.com";
 constexpr int API_REPOS_PER_PAGE = 100;
 constexpr int MAX_DESCRIPTION_LENGTH = 350;
 constexpr int MAX_REPO_NAME_LENGTH = 100;
+constexpr int API_MAX_CONNECTIONS = 4;
+constexpr int API_MAX_PARALLEL_PAGES = 4;
+constexpr int API_MAX_PARALLEL_OWNERS = 8;  // Organizations listed at once
+constexpr int API_ASYNC_THREADS = 8;
+constexpr int EXISTS_CACHE_TTL = 30;  // seconds
+constexpr const char* GRAPHQL_PATH = "/graphql";
+
+// Rate limiting
+constexpr int API_MAX_CONCURRENCY = 8;
+constexpr int API_MAX_RETRIES = 3;
+constexpr int API_RETRY_BASE_MS = 500;
+constexpr int API_MUTATION_INTERVAL_MS = 1000;
+constexpr int API_MAX_RATE_LIMIT_WAIT = 60;  // seconds
 
 // Git
 constexpr const char* DEFAULT_REMOTE = "origin";
@@ -18,6 +33,27 @@ constexpr const char* DEFAULT_BRANCH = "main";
 constexpr const char* CONFIG_FILE = ".gh-repo-create.json";
 constexpr const char* HISTORY_FILE = ".gh-repo-create-history";
 constexpr const char* GIT_CONFIG_USER_KEY = "github.user";
+constexpr const char* DATA_DIR = ".gh-repo-create";
+constexpr const char* CACHE_DIR = "cache";
+constexpr size_t CACHE_MAX_BYTES = 32 * 1024 * 1024;  // ETag cache size kept after pruning
+constexpr int CACHE_MAX_AGE = 30 * 24 * 60 * 60;       // seconds an ETag cache entry is kept
+constexpr const char* INDEX_FILE_PREFIX = "repo-index-";
+constexpr const char* IDENTITY_FILE_PREFIX = "identity-";
+constexpr int IDENTITY_CACHE_TTL = 24 * 60 * 60;  // seconds a cached GET /user answer is trusted
+
+// Repository index
+constexpr int INDEX_FULL_SYNC_INTERVAL = 24 * 60 * 60;  // seconds
+constexpr int REPL_PREFETCH_TTL = 60;  // seconds a startup prefetch is trusted
+constexpr size_t SEARCH_PICKER_LIMIT = 30;      // Repositories offered at once by the delete picker
+constexpr size_t SEARCH_COMPLETION_LIMIT = 50;  // Names offered by Tab completion
+
+// Machine-readable output (--format)
+constexpr size_t OUTPUT_BUFFER_SIZE = 64 * 1024;  // bytes buffered before a write
+
+// Metrics
+constexpr const char* METRICS_PREFIX = "gh_repo";
+// Upper bounds (seconds) of the latency histogram buckets, +Inf implied
+constexpr double METRICS_LATENCY_BUCKETS[] = {0.01, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30};
 
 // Timeouts (seconds)
 constexpr int SSH_TIMEOUT = 30;
@@ -0,0 +1,252 @@
+/**
+ * @file curl_transport.cpp
+ * @brief libcurl multi transport: all requests on one event-loop thread
+ *
+ * Requests from any number of threads are handed to a single curl multi
+ * handle. Over HTTPS, libcurl negotiates HTTP/2 and multiplexes concurrent
+ * requests as streams on one connection (PIPEWAIT makes later requests wait
+ * for that connection instead of opening more); against HTTP/1.1 servers it
+ * falls back to at most maxConnections keep-alive connections. Socket I/O,
+ * TLS and decompression all happen on the loop thread, so an in-flight
+ * request costs a stream, not a connection or a thread.
+ */
+
+#include "transport.h"
+#include <curl/curl.h>
+#include <atomic>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief One request while it is owned by the event loop
+ */
+struct Transfer {
+    HttpRequest request;
+    HttpResponse response;
+    std::promise<HttpResponse> done;
+    CURL* easy = nullptr;
+    curl_slist* headers = nullptr;
+
+    ~Transfer() {
+        if (headers) curl_slist_free_all(headers);
+        if (easy) curl_easy_cleanup(easy);
+    }
+};
+
+size_t onBody(char* data, size_t size, size_t count, void* user) {
+    static_cast<Transfer*>(user)->response.body.append(data, size * count);
+    return size * count;
+}
+
+/**
+ * @brief Collects "Name: value" header lines; a new status line starts over
+ *        (interim 1xx responses)
+ */
+size_t onHeader(char* data, size_t size, size_t count, void* user) {
+    auto* transfer = static_cast<Transfer*>(user);
+    size_t length = size * count;
+    std::string line(data, length);
+    while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
+        line.pop_back();
+    }
+    if (line.rfind("HTTP/", 0) == 0) {
+        transfer->response.headers.clear();
+    } else {
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+            size_t value = line.find_first_not_of(" \t", colon + 1);
+            transfer->response.headers.emplace_back(
+                line.substr(0, colon), value == std::string::npos ? "" : line.substr(value));
+        }
+    }
+    return length;
+}
+
+Clock::time_point offset(Clock::time_point start, curl_off_t micros) {
+    return start + std::chrono::microseconds(micros);
+}
+
+class CurlTransport : public Transport {
+public:
+    explicit CurlTransport(const TransportConfig& config) : config_(config) {
+        static std::once_flag globalInit;
+        std::call_once(globalInit, []() { curl_global_init(CURL_GLOBAL_DEFAULT); });
+
+        multi_ = curl_multi_init();
+        curl_multi_setopt(multi_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(config_.maxConnections));
+        loop_ = std::thread([this]() { run(); });
+    }
+
+    ~CurlTransport() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        curl_multi_wakeup(multi_);
+        loop_.join();
+        curl_multi_cleanup(multi_);
+    }
+
+    const char* name() const override { return "curl"; }
+    void setDebug(bool debug) override { debug_ = debug; }
+
+    HttpResponse send(const HttpRequest& request) override {
+        auto transfer = std::make_unique<Transfer>();
+        transfer->request = request;
+        auto result = transfer->done.get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.push_back(std::move(transfer));
+        }
+        curl_multi_wakeup(multi_);
+        return result.get();
+    }
+
+private:
+    /**
+     * @brief Builds the easy handle for a queued request
+     */
+    void prepare(Transfer& t) {
+        const HttpRequest& request = t.request;
+        t.easy = curl_easy_init();
+        std::string url = config_.baseUrl + request.path;
+        curl_easy_setopt(t.easy, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(t.easy, CURLOPT_PRIVATE, &t);
+        curl_easy_setopt(t.easy, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(t.easy, CURLOPT_PIPEWAIT, 1L);
+        curl_easy_setopt(t.easy, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+        long timeout = request.timeout > 0 ? request.timeout : config_.timeout;
+        curl_easy_setopt(t.easy, CURLOPT_CONNECTTIMEOUT, timeout);
+        curl_easy_setopt(t.easy, CURLOPT_TIMEOUT, timeout);
+        curl_easy_setopt(t.easy, CURLOPT_WRITEFUNCTION, onBody);
+        curl_easy_setopt(t.easy, CURLOPT_WRITEDATA, &t);
+        curl_easy_setopt(t.easy, CURLOPT_HEADERFUNCTION, onHeader);
+        curl_easy_setopt(t.easy, CURLOPT_HEADERDATA, &t);
+
+        if (request.method == "POST" || request.method == "PATCH") {
+            curl_easy_setopt(t.easy, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(request.body.size()));
+            curl_easy_setopt(t.easy, CURLOPT_COPYPOSTFIELDS, request.body.c_str());
+            if (request.method == "PATCH") {
+                curl_easy_setopt(t.easy, CURLOPT_CUSTOMREQUEST, "PATCH");
+            }
+        } else if (request.method != "GET") {
+            curl_easy_setopt(t.easy, CURLOPT_CUSTOMREQUEST, request.method.c_str());
+        }
+
+        auto add = [&t](const std::string& name, const std::string& value) {
+            t.headers = curl_slist_append(t.headers, (name + ": " + value).c_str());
+        };
+        for (const auto& [name, value] : config_.defaultHeaders) add(name, value);
+        for (const auto& [name, value] : request.headers) {
+            // libcurl only decodes bodies when it negotiated the encoding itself
+            if (name == "Accept-Encoding") {
+                curl_easy_setopt(t.easy, CURLOPT_ACCEPT_ENCODING, value.c_str());
+            } else {
+                add(name, value);
+            }
+        }
+        if (!request.body.empty()) add("Content-Type", request.contentType);
+        t.headers = curl_slist_append(t.headers, "Expect:");
+        curl_easy_setopt(t.easy, CURLOPT_HTTPHEADER, t.headers);
+    }
+
+    /**
+     * @brief Fills status, phase times and connection details, then hands the
+     *        response back to the waiting caller
+     */
+    void finish(Transfer* t, CURLcode code) {
+        HttpResponse& response = t->response;
+        if (code != CURLE_OK) {
+            response.error = curl_easy_strerror(code);
+        } else {
+            long status = 0;
+            curl_easy_getinfo(t->easy, CURLINFO_RESPONSE_CODE, &status);
+            response.status = static_cast<int>(status);
+        }
+
+        long connects = 0, version = 0;
+        curl_off_t connect = 0, handshake = 0, firstByte = 0;
+        curl_easy_getinfo(t->easy, CURLINFO_NUM_CONNECTS, &connects);
+        curl_easy_getinfo(t->easy, CURLINFO_HTTP_VERSION, &version);
+        curl_easy_getinfo(t->easy, CURLINFO_CONNECT_TIME_T, &connect);
+        curl_easy_getinfo(t->easy, CURLINFO_APPCONNECT_TIME_T, &handshake);
+        curl_easy_getinfo(t->easy, CURLINFO_STARTTRANSFER_TIME_T, &firstByte);
+        response.reused = connects == 0;
+        response.httpVersion = version == CURL_HTTP_VERSION_2_0 ? "2" :
+                               version == CURL_HTTP_VERSION_3 ? "3" :
+                               version == CURL_HTTP_VERSION_1_0 ? "1.0" : "1.1";
+        if (!response.reused && connect > 0) response.connectedAt = offset(response.sentAt, connect);
+        if (!response.reused && handshake > 0) response.handshakeAt = offset(response.sentAt, handshake);
+        if (firstByte > 0) response.headersAt = offset(response.sentAt, firstByte);
+
+        if (debug_) {
+            std::cerr << "[DEBUG] curl: " << t->request.method << " " << t->request.path << " over HTTP/"
+                      << response.httpVersion << (response.reused ? " (multiplexed/reused connection)" : " (new connection)")
+                      << ", " << active_ << " transfer(s) in flight\n";
+        }
+
+        curl_multi_remove_handle(multi_, t->easy);
+        t->done.set_value(std::move(response));
+    }
+
+    /**
+     * @brief Event loop: adds queued transfers, drives I/O, completes finished ones
+     */
+    void run() {
+        std::unordered_map<Transfer*, std::unique_ptr<Transfer>> active;
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (stopping_ && pending_.empty() && active.empty()) break;
+                while (!pending_.empty()) {
+                    auto transfer = std::move(pending_.front());
+                    pending_.pop_front();
+                    prepare(*transfer);
+                    transfer->response.sentAt = Clock::now();
+                    curl_multi_add_handle(multi_, transfer->easy);
+                    Transfer* key = transfer.get();
+                    active.emplace(key, std::move(transfer));
+                }
+            }
+
+            int running = 0;
+            curl_multi_perform(multi_, &running);
+            active_ = running;
+
+            int queued = 0;
+            while (CURLMsg* message = curl_multi_info_read(multi_, &queued)) {
+                if (message->msg != CURLMSG_DONE) continue;
+                Transfer* transfer = nullptr;
+                curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &transfer);
+                finish(transfer, message->data.result);
+                active.erase(transfer);
+            }
+
+            curl_multi_poll(multi_, nullptr, 0, 1000, nullptr);
+        }
+    }
+
+    TransportConfig config_;
+    CURLM* multi_ = nullptr;
+    std::thread loop_;
+    std::mutex mutex_;
+    std::deque<std::unique_ptr<Transfer>> pending_;
+    bool stopping_ = false;
+    int active_ = 0;  // Loop thread only
+    std::atomic<bool> debug_{false};
+};
+
+}  // namespace
+
+std::unique_ptr<Transport> makeCurlTransport(const TransportConfig& config) {
+    return std::make_unique<CurlTransport>(config);
+}
@@ -0,0 +1,51 @@
+/**
+ * @file executor.cpp
+ * @brief Thread pool behind GitHubClient's asynchronous API
+ */
+
+#include "executor.h"
+#include <algorithm>
+
+Executor::Executor(size_t threads) {
+    size_t count = std::max<size_t>(1, threads);
+    workers_.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        workers_.emplace_back([this]() { run(); });
+    }
+}
+
+Executor::~Executor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void Executor::enqueue(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(job));
+    }
+    cv_.notify_one();
+}
+
+/**
+ * @brief Worker loop: runs queued jobs until stopped and the queue is empty
+ */
+void Executor::run() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;
+            job = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        job();
+    }
+}
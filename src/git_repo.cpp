@@ -0,0 +1,418 @@
+/**
+ * @file git_repo.cpp
+ * @brief In-process reader for HEAD, refs and config of a git repository
+ *
+ * Every GitUtils query used to run `cd "<path>" && git ...` through a shell,
+ * a fork and exec of both sh and git for a few bytes of state, and
+ * hasRemote() ran `git remote show`, which connects to the remote. The files
+ * behind those answers are small and stable in format, so they are read
+ * here directly.
+ */
+
+#include "git_repo.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int MAX_INCLUDE_DEPTH = 10;
+constexpr int MAX_SYMREF_DEPTH = 5;
+
+std::optional<std::string> readFile(const fs::path& path) {
+    std::error_code ec;
+    if (!fs::is_regular_file(path, ec)) return std::nullopt;
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return std::nullopt;
+    std::ostringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+std::string trim(std::string_view text) {
+    size_t begin = 0, end = text.size();
+    while (begin < end && std::isspace(static_cast<unsigned char>(text[begin]))) begin++;
+    while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1]))) end--;
+    return std::string(text.substr(begin, end - begin));
+}
+
+std::string lower(std::string_view text) {
+    std::string out(text);
+    std::transform(out.begin(), out.end(), out.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return out;
+}
+
+/**
+ * @brief A SHA-1 or SHA-256 object id
+ */
+bool isObjectId(std::string_view text) {
+    if (text.size() != 40 && text.size() != 64) return false;
+    return std::all_of(text.begin(), text.end(), [](unsigned char c) { return std::isxdigit(c) != 0; });
+}
+
+/**
+ * @brief Target of a "ref: <name>" symbolic ref, or empty
+ */
+std::string symrefTarget(std::string_view content) {
+    std::string text = trim(content);
+    if (text.compare(0, 4, "ref:") != 0) return "";
+    return trim(std::string_view(text).substr(4));
+}
+
+/**
+ * @brief "section.Sub.Name" -> "section.Sub.name": section and variable
+ *        names are case-insensitive, subsections are not
+ */
+std::string normalizeKey(std::string_view key) {
+    size_t first = key.find('.');
+    size_t last = key.rfind('.');
+    if (first == std::string_view::npos) return lower(key);
+    if (first == last) return lower(key);
+    return lower(key.substr(0, first)) + std::string(key.substr(first, last - first)) + lower(key.substr(last));
+}
+
+bool isTrue(const std::optional<std::string>& value) {
+    if (!value) return false;
+    std::string v = lower(*value);
+    return v == "true" || v == "yes" || v == "on" || v == "1";
+}
+
+/**
+ * @brief Git's test for a git directory: a valid HEAD, plus objects and refs
+ *        in the common directory
+ */
+bool isGitDir(const fs::path& dir, fs::path& commonDir) {
+    std::error_code ec;
+    commonDir = dir;
+    if (auto common = readFile(dir / "commondir")) {
+        fs::path target = trim(*common);
+        commonDir = target.is_absolute() ? target : dir / target;
+    }
+    if (!fs::is_directory(commonDir / "objects", ec) || !fs::is_directory(commonDir / "refs", ec)) {
+        return false;
+    }
+    auto head = readFile(dir / "HEAD");
+    if (!head) return false;
+    return symrefTarget(*head).compare(0, 5, "refs/") == 0 || isObjectId(trim(*head));
+}
+
+/**
+ * @brief Refs kept per worktree rather than in the common directory
+ */
+bool isPerWorktreeRef(const std::string& ref) {
+    return ref.compare(0, 5, "refs/") != 0 || ref.compare(0, 14, "refs/worktree/") == 0 ||
+           ref.compare(0, 12, "refs/bisect/") == 0 || ref.compare(0, 15, "refs/rewritten/") == 0;
+}
+
+fs::path expandPath(const std::string& path, const fs::path& relativeTo) {
+    if (path.compare(0, 2, "~/") == 0) {
+        const char* home = std::getenv("HOME");
+        return fs::path(home ? home : "") / path.substr(2);
+    }
+    fs::path p = path;
+    return p.is_absolute() ? p : relativeTo / p;
+}
+
+/**
+ * @brief Parses one value after '=', up to the end of its (possibly continued) line
+ *
+ * Follows git's rules: double quotes group, a backslash escapes n, t, b, a
+ * quote or itself and joins lines, # and ; outside quotes start a comment,
+ * and unquoted whitespace at either end is dropped.
+ */
+std::string parseValue(const std::string& text, size_t& i) {
+    while (i < text.size() && (text[i] == ' ' || text[i] == '\t')) i++;
+    std::string value;
+    size_t kept = 0;  // Length up to the last character that is not trailing whitespace
+    bool quoted = false;
+    while (i < text.size()) {
+        char c = text[i++];
+        if (c == '\n') break;
+        if (!quoted && (c == '#' || c == ';')) {
+            while (i < text.size() && text[i] != '\n') i++;
+            break;
+        }
+        if (c == '\\' && i < text.size()) {
+            char escaped = text[i++];
+            if (escaped == '\r' && i < text.size() && text[i] == '\n') {
+                escaped = text[i++];
+            }
+            if (escaped == '\n') continue;  // Line continuation
+            value += escaped == 'n' ? '\n' : escaped == 't' ? '\t' : escaped == 'b' ? '\b' : escaped;
+            kept = value.size();
+            continue;
+        }
+        if (c == '"') {
+            quoted = !quoted;
+            kept = value.size();
+            continue;
+        }
+        if (c == '\r' && !quoted) continue;
+        value += c;
+        if (quoted || !std::isspace(static_cast<unsigned char>(c))) kept = value.size();
+    }
+    value.resize(kept);
+    return value;
+}
+
+void parseConfigFile(const fs::path& file, bool conditional, int depth,
+                     std::vector<GitRepo::ConfigEntry>& out);
+
+/**
+ * @brief Appends the entries of one config file, following includes
+ */
+void parseConfig(const std::string& text, const fs::path& dir, bool conditional, int depth,
+                 std::vector<GitRepo::ConfigEntry>& out) {
+    std::string section;  // "remote.origin" or "core"; empty before the first header
+    size_t i = 0;
+    while (i < text.size()) {
+        char c = text[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            i++;
+        } else if (c == '#' || c == ';') {
+            while (i < text.size() && text[i] != '\n') i++;
+        } else if (c == '[') {
+            // [section "subsection"] or the older [section.subsection]
+            size_t nameStart = ++i;
+            while (i < text.size() && text[i] != ']' && text[i] != '"' &&
+                   !std::isspace(static_cast<unsigned char>(text[i]))) {
+                i++;
+            }
+            section = lower(std::string_view(text).substr(nameStart, i - nameStart));
+            while (i < text.size() && (text[i] == ' ' || text[i] == '\t')) i++;
+            if (i < text.size() && text[i] == '"') {
+                std::string subsection;
+                for (i++; i < text.size() && text[i] != '"' && text[i] != '\n'; i++) {
+                    if (text[i] == '\\' && i + 1 < text.size()) i++;
+                    subsection += text[i];
+                }
+                section += "." + subsection;
+                if (i < text.size() && text[i] == '"') i++;
+            }
+            while (i < text.size() && text[i] != ']' && text[i] != '\n') i++;
+            if (i < text.size() && text[i] == ']') i++;
+        } else if (std::isalpha(static_cast<unsigned char>(c))) {
+            size_t nameStart = i;
+            while (i < text.size() && (std::isalnum(static_cast<unsigned char>(text[i])) || text[i] == '-')) i++;
+            std::string name = lower(std::string_view(text).substr(nameStart, i - nameStart));
+            while (i < text.size() && (text[i] == ' ' || text[i] == '\t')) i++;
+
+            std::string value = "true";  // A bare name is a boolean
+            if (i < text.size() && text[i] == '=') {
+                value = parseValue(text, ++i);
+            } else {
+                while (i < text.size() && text[i] != '\n') i++;
+            }
+            if (section.empty()) continue;
+
+            out.push_back({section + "." + name, value, conditional});
+            if (name == "path" && section == "include") {
+                parseConfigFile(expandPath(value, dir), conditional, depth + 1, out);
+            } else if (name == "path" && section.compare(0, 10, "includeif.") == 0) {
+                parseConfigFile(expandPath(value, dir), true, depth + 1, out);
+            }
+        } else {
+            while (i < text.size() && text[i] != '\n') i++;  // Not valid config; git would refuse it
+        }
+    }
+}
+
+void parseConfigFile(const fs::path& file, bool conditional, int depth,
+                     std::vector<GitRepo::ConfigEntry>& out) {
+    if (depth > MAX_INCLUDE_DEPTH) return;
+    if (auto text = readFile(file)) {
+        parseConfig(*text, file.parent_path(), conditional, depth, out);
+    }
+}
+
+/**
+ * @brief True if dir and its parent are on different filesystems, where
+ *        git stops looking for a repository
+ */
+bool crossesFilesystem(const fs::path& dir, const fs::path& parent) {
+    if (std::getenv("GIT_DISCOVERY_ACROSS_FILESYSTEM")) return false;
+    struct stat here, up;
+    if (stat(dir.c_str(), &here) != 0 || stat(parent.c_str(), &up) != 0) return false;
+    return here.st_dev != up.st_dev;
+}
+
+}  // namespace
+
+bool GitRepo::environmentOverrides() {
+    for (const char* name : {"GIT_DIR", "GIT_WORK_TREE", "GIT_COMMON_DIR", "GIT_CEILING_DIRECTORIES",
+                             "GIT_CONFIG", "GIT_CONFIG_PARAMETERS", "GIT_CONFIG_COUNT"}) {
+        if (std::getenv(name)) return true;
+    }
+    return false;
+}
+
+std::optional<GitRepo> GitRepo::discover(const std::string& path) {
+    std::error_code ec;
+    fs::path dir = fs::canonical(path, ec);
+    if (ec || !fs::is_directory(dir, ec)) return std::nullopt;
+
+    while (true) {
+        fs::path gitDir, commonDir;
+        fs::path dotGit = dir / ".git";
+        if (fs::is_directory(dotGit, ec)) {
+            gitDir = dotGit;
+        } else if (auto link = readFile(dotGit)) {
+            // Linked worktrees and submodules: "gitdir: <path>"
+            std::string text = trim(*link);
+            if (text.compare(0, 7, "gitdir:") == 0) {
+                fs::path target = trim(std::string_view(text).substr(7));
+                gitDir = target.is_absolute() ? target : dir / target;
+            }
+        }
+
+        bool found = !gitDir.empty() && isGitDir(gitDir, commonDir);
+        if (!found && isGitDir(dir, commonDir)) {
+            gitDir = dir;  // Bare repository
+            found = true;
+        }
+        if (found) {
+            GitRepo repo;
+            repo.gitDir_ = fs::weakly_canonical(gitDir, ec).string();
+            repo.commonDir_ = fs::weakly_canonical(commonDir, ec).string();
+            repo.loadConfig();
+            return repo;
+        }
+
+        fs::path parent = dir.parent_path();
+        if (parent == dir || crossesFilesystem(dir, parent)) return std::nullopt;
+        dir = parent;
+    }
+}
+
+/**
+ * @brief Reads system, global, repository and worktree config, in git's order
+ */
+void GitRepo::loadConfig() {
+    config_.clear();
+    if (!std::getenv("GIT_CONFIG_NOSYSTEM")) {
+        const char* system = std::getenv("GIT_CONFIG_SYSTEM");
+        parseConfigFile(system ? system : "/etc/gitconfig", false, 0, config_);
+    }
+
+    const char* home = std::getenv("HOME");
+    if (const char* global = std::getenv("GIT_CONFIG_GLOBAL")) {
+        parseConfigFile(global, false, 0, config_);
+    } else {
+        const char* xdg = std::getenv("XDG_CONFIG_HOME");
+        if (xdg && *xdg) {
+            parseConfigFile(fs::path(xdg) / "git" / "config", false, 0, config_);
+        } else if (home) {
+            parseConfigFile(fs::path(home) / ".config" / "git" / "config", false, 0, config_);
+        }
+        if (home) {
+            parseConfigFile(fs::path(home) / ".gitconfig", false, 0, config_);
+        }
+    }
+
+    parseConfigFile(fs::path(commonDir_) / "config", false, 0, config_);
+    if (isTrue(configValue("extensions.worktreeConfig"))) {
+        parseConfigFile(fs::path(gitDir_) / "config.worktree", false, 0, config_);
+    }
+}
+
+std::optional<std::string> GitRepo::configValue(const std::string& key) const {
+    std::string normalized = normalizeKey(key);
+    for (auto it = config_.rbegin(); it != config_.rend(); ++it) {
+        if (it->key == normalized) return it->value;
+    }
+    return std::nullopt;
+}
+
+bool GitRepo::configComplete(std::string_view prefix) const {
+    std::string normalized = lower(prefix);
+    return std::none_of(config_.begin(), config_.end(), [&](const ConfigEntry& entry) {
+        return entry.conditional && lower(entry.key).compare(0, normalized.size(), normalized) == 0;
+    });
+}
+
+bool GitRepo::hasRemote(const std::string& name) const {
+    std::string section = "remote." + name + ".";
+    return std::any_of(config_.begin(), config_.end(), [&](const ConfigEntry& entry) {
+        return entry.key.compare(0, section.size(), section) == 0;
+    });
+}
+
+std::optional<std::string> GitRepo::remoteUrl(const std::string& name) const {
+    std::string key = "remote." + name + ".url";
+    auto url = std::find_if(config_.begin(), config_.end(),
+                            [&](const ConfigEntry& entry) { return entry.key == key; });
+    if (url == config_.end()) return std::nullopt;
+
+    // url.<base>.insteadOf: the longest matching prefix is replaced by its base
+    std::string rewritten = url->value;
+    size_t longest = 0;
+    for (const auto& entry : config_) {
+        if (entry.key.compare(0, 4, "url.") != 0 || entry.key.size() < 15 ||
+            entry.key.compare(entry.key.size() - 10, 10, ".insteadof") != 0) {
+            continue;
+        }
+        const std::string& prefix = entry.value;
+        if (prefix.size() > longest && url->value.compare(0, prefix.size(), prefix) == 0) {
+            longest = prefix.size();
+            rewritten = entry.key.substr(4, entry.key.size() - 14) + url->value.substr(prefix.size());
+        }
+    }
+    return rewritten;
+}
+
+std::optional<std::string> GitRepo::resolveRef(const std::string& ref) const {
+    std::string name = ref;
+    for (int depth = 0; depth < MAX_SYMREF_DEPTH; depth++) {
+        const std::string& base = isPerWorktreeRef(name) ? gitDir_ : commonDir_;
+        if (auto loose = readFile(fs::path(base) / name)) {
+            std::string target = symrefTarget(*loose);
+            if (!target.empty()) {
+                name = target;
+                continue;
+            }
+            std::string id = trim(*loose);
+            return isObjectId(id) ? std::make_optional(id) : std::nullopt;
+        }
+
+        // "<id> <ref>" lines; '#' starts the header, '^' a peeled tag
+        auto packed = readFile(fs::path(commonDir_) / "packed-refs");
+        if (!packed) return std::nullopt;
+        std::istringstream lines(*packed);
+        std::string line;
+        while (std::getline(lines, line)) {
+            if (line.empty() || line[0] == '#' || line[0] == '^') continue;
+            size_t space = line.find(' ');
+            if (space != std::string::npos && trim(std::string_view(line).substr(space + 1)) == name) {
+                return line.substr(0, space);
+            }
+        }
+        return std::nullopt;
+    }
+    return std::nullopt;
+}
+
+std::optional<GitHead> GitRepo::head() const {
+    // With reftable, HEAD only holds a placeholder and refs live in tables
+    auto storage = configValue("extensions.refStorage");
+    if (storage && lower(*storage) != "files") return std::nullopt;
+
+    auto content = readFile(fs::path(gitDir_) / "HEAD");
+    if (!content) return std::nullopt;
+
+    GitHead head;
+    std::string ref = symrefTarget(*content);
+    if (ref.empty()) {
+        head.commit = trim(*content);
+        return head;
+    }
+    head.branch = ref.compare(0, 11, "refs/heads/") == 0 ? ref.substr(11) : ref;
+    head.commit = resolveRef(ref).value_or("");
+    return head;
+}
@@ -0,0 +1,97 @@
+#ifndef GIT_REPO_H
+#define GIT_REPO_H
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief What HEAD points at
+ */
+struct GitHead {
+    std::string branch;  // Branch name, empty when HEAD is detached
+    std::string commit;  // Object id, empty on a branch with no commits yet
+};
+
+/**
+ * @brief A repository's state, read from its git directory without running git
+ *
+ * discover() finds the repository the way git does from a working
+ * directory: it walks up from the path looking for a .git directory, a .git
+ * file ("gitdir: ..." for worktrees and submodules) or a bare repository,
+ * following commondir for linked worktrees. The system, global, repository
+ * and worktree config files are then parsed, with include.path followed.
+ *
+ * Two things are not modeled, and callers should ask git itself instead:
+ * includeIf conditions (configComplete() reports whether one of those files
+ * sets keys under a prefix) and the reftable ref backend (head() returns
+ * nothing). environmentOverrides() reports GIT_DIR and similar variables,
+ * which change how git would answer.
+ */
+class GitRepo {
+public:
+    /**
+     * @brief Opens the repository containing path
+     * @return std::nullopt if path is not inside a git repository
+     */
+    static std::optional<GitRepo> discover(const std::string& path);
+
+    /**
+     * @brief True if the environment redirects git (GIT_DIR, GIT_CONFIG_COUNT, ...)
+     */
+    static bool environmentOverrides();
+
+    const std::string& gitDir() const { return gitDir_; }
+    const std::string& commonDir() const { return commonDir_; }
+
+    /**
+     * @brief Current branch and commit
+     * @return std::nullopt if HEAD cannot be read here (e.g. reftable)
+     */
+    std::optional<GitHead> head() const;
+
+    /**
+     * @brief Object id of a ref, following symbolic refs, from the loose
+     *        ref file or else packed-refs
+     */
+    std::optional<std::string> resolveRef(const std::string& ref) const;
+
+    /**
+     * @brief Last value of a config key such as "core.bare"; section and
+     *        variable names are case-insensitive, subsections are not
+     */
+    std::optional<std::string> configValue(const std::string& key) const;
+
+    /**
+     * @brief False if a conditionally included config file sets a key
+     *        starting with prefix (e.g. "remote."), so answers may differ from git's
+     */
+    bool configComplete(std::string_view prefix) const;
+
+    /**
+     * @brief True if any remote.<name>.* key is set
+     */
+    bool hasRemote(const std::string& name) const;
+
+    /**
+     * @brief First remote.<name>.url with url.<base>.insteadOf applied, as
+     *        `git remote get-url` prints it
+     */
+    std::optional<std::string> remoteUrl(const std::string& name) const;
+
+    struct ConfigEntry {
+        std::string key;     // section[.subsection].name, section and name lowercased
+        std::string value;
+        bool conditional;    // From an includeIf file, which may not apply
+    };
+
+private:
+    void loadConfig();
+
+    std::string gitDir_;
+    std::string commonDir_;
+    std::vector<ConfigEntry> config_;
+};
+
+#endif
@@ -1,10 +1,41 @@
 #include "git_utils.h"
+#include "git_repo.h"
+#include "metrics.h"
+#include "trace.h"
+#include <chrono>
 #include <iostream>
 #include <cstdlib>
 #include <memory>
 #include <optional>
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Trace span name for a command: drops the leading `cd "<path>" && `
+static std::string spanName(const std::string& cmd) {
+    size_t pos = cmd.find(" && ");
+    return pos == std::string::npos ? cmd : cmd.substr(pos + 4);
+}
+
+// Metrics label for a command: the program and subcommand, e.g. "git push"
+static std::string commandLabel(const std::string& name) {
+    size_t first = name.find(' ');
+    if (first == std::string::npos) return name;
+    size_t second = name.find(' ', first + 1);
+    return name.substr(0, second);
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
 
 static std::string runCommand(const std::string& cmd) {
+    std::string name = spanName(cmd);
+    Trace::Span span(name, "git");
+    auto start = std::chrono::steady_clock::now();
     std::array<char, 128> buffer;
     std::string result;
     std::unique_ptr<FILE, decltype(&pclose)> pipe(popen(cmd.c_str(), "r"), pclose);
@@ -12,6 +43,9 @@ static std::string runCommand(const std::string& cmd) {
     while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) {
         result += buffer.data();
     }
+    pipe.reset();
+    Metrics::instance().recordSubprocess(commandLabel(name), secondsSince(start));
+    span.set("bytes", static_cast<double>(result.size()));
     if (!result.empty() && result.back() == '\n') {
         result.pop_back();
     }
@@ -19,30 +53,140 @@ static std::string runCommand(const std::string& cmd) {
 }
 
 static int runCommandExit(const std::string& cmd) {
-    return system(cmd.c_str());
+    std::string name = spanName(cmd);
+    Trace::Span span(name, "git");
+    auto start = std::chrono::steady_clock::now();
+    int status = system(cmd.c_str());
+    Metrics::instance().recordSubprocess(commandLabel(name), secondsSince(start));
+    span.set("status", status);
+    return status;
+}
+
+/**
+ * @brief Runs a shell command, killing it if it has not finished in time
+ * @param cmd Command line for /bin/sh -c; stdout and stderr are captured together
+ * @param timeoutSeconds Wall-clock limit
+ *
+ * The command runs in its own process group so that everything it started
+ * (ssh and its proxies, say) is killed on timeout.
+ */
+CommandResult GitUtils::runWithTimeout(const std::string& cmd, int timeoutSeconds) {
+    std::string name = spanName(cmd);
+    Trace::Span span(name, name.rfind("ssh", 0) == 0 ? "ssh" : "git");
+    auto start = std::chrono::steady_clock::now();
+    CommandResult result;
+    
+    int fds[2];
+    if (pipe(fds) != 0) return result;
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return result;
+    }
+    if (pid == 0) {
+        setpgid(0, 0);
+        dup2(fds[1], STDOUT_FILENO);
+        dup2(fds[1], STDERR_FILENO);
+        close(fds[0]);
+        close(fds[1]);
+        int devNull = open("/dev/null", O_RDONLY);
+        if (devNull >= 0) dup2(devNull, STDIN_FILENO);
+        execl("/bin/sh", "sh", "-c", cmd.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    setpgid(pid, pid);
+    close(fds[1]);
+    
+    auto deadline = start + std::chrono::seconds(timeoutSeconds);
+    char buffer[512];
+    while (true) {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (left.count() <= 0) {
+            result.timedOut = true;
+            kill(-pid, SIGKILL);
+            break;
+        }
+        pollfd pfd{fds[0], POLLIN, 0};
+        int ready = poll(&pfd, 1, static_cast<int>(left.count()));
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready < 0) {
+            kill(-pid, SIGKILL);
+            break;
+        }
+        if (ready == 0) continue;
+        ssize_t n = read(fds[0], buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        result.output.append(buffer, static_cast<size_t>(n));
+    }
+    close(fds[0]);
+    
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+    if (!result.timedOut && WIFEXITED(status)) {
+        result.exitCode = WEXITSTATUS(status);
+    }
+    Metrics::instance().recordSubprocess(commandLabel(name), secondsSince(start));
+    span.set("status", result.exitCode);
+    if (result.timedOut) span.set("error", "timed out");
+    return result;
 }
 
 void GitUtils::configureSshForGitHub() {
     runCommandExit("git config --global url.\"git@github.com:\".insteadOf \"https://github.com/\"");
 }
 
+// The queries below read the repository in-process with GitRepo and only
+// run git when the environment or config uses something GitRepo does not model
+
 bool GitUtils::isGitRepo(const std::string& path) {
+    if (!GitRepo::environmentOverrides()) {
+        return GitRepo::discover(path).has_value();
+    }
     std::string cmd = "cd \"" + path + "\" && git rev-parse --git-dir > /dev/null 2>&1";
     return runCommandExit(cmd) == 0;
 }
 
+/**
+ * @brief Current branch, "HEAD" when detached (as `git rev-parse --abbrev-ref HEAD`)
+ *
+ * A branch with no commits yet is still reported by name.
+ */
 std::optional<std::string> GitUtils::getCurrentBranch(const std::string& path) {
-    std::string cmd = "cd \"" + path + "\" && git rev-parse --abbrev-ref HEAD";
+    if (!GitRepo::environmentOverrides()) {
+        auto repo = GitRepo::discover(path);
+        if (!repo) return std::nullopt;
+        if (auto head = repo->head()) {
+            return head->branch.empty() ? "HEAD" : head->branch;
+        }
+    }
+    std::string cmd = "cd \"" + path + "\" && git rev-parse --abbrev-ref HEAD 2>/dev/null";
     std::string branch = runCommand(cmd);
     return branch.empty() ? std::nullopt : std::make_optional(branch);
 }
 
+/**
+ * @brief True if the remote is configured; never contacts it
+ */
 bool GitUtils::hasRemote(const std::string& path, const std::string& remoteName) {
-    std::string cmd = "cd \"" + path + "\" && git remote show " + remoteName + " 2>/dev/null";
+    if (!GitRepo::environmentOverrides()) {
+        auto repo = GitRepo::discover(path);
+        if (!repo) return false;
+        if (repo->configComplete("remote.")) return repo->hasRemote(remoteName);
+    }
+    std::string cmd = "cd \"" + path + "\" && git remote get-url " + remoteName + " > /dev/null 2>&1";
     return runCommandExit(cmd) == 0;
 }
 
 std::optional<std::string> GitUtils::getRemoteUrl(const std::string& path, const std::string& remoteName) {
+    if (!GitRepo::environmentOverrides()) {
+        auto repo = GitRepo::discover(path);
+        if (!repo) return std::nullopt;
+        if (repo->configComplete("remote.") && repo->configComplete("url.")) {
+            return repo->remoteUrl(remoteName);
+        }
+    }
     std::string cmd = "cd \"" + path + "\" && git remote get-url " + remoteName + " 2>/dev/null";
     std::string url = runCommand(cmd);
     return url.empty() ? std::nullopt : std::make_optional(url);
@@ -54,9 +198,10 @@ bool GitUtils::addRemote(const std::string& path, const std::string& name, const
 }
 
 bool GitUtils::push(const std::string& path, const std::string& remote, const std::string& branch) {
-    std::string cmd = "cd \"" + path + "\" && git push -u " + remote + " " + branch;
+    // git's own messages go to stderr, keeping stdout for --format records
+    std::string cmd = "cd \"" + path + "\" && git push -u " + remote + " " + branch + " 1>&2";
     if (runCommandExit(cmd) != 0) {
-        cmd = "cd \"" + path + "\" && git push -u " + remote + " " + branch + " --force";
+        cmd = "cd \"" + path + "\" && git push -u " + remote + " " + branch + " --force 1>&2";
         return runCommandExit(cmd) == 0;
     }
     return true;
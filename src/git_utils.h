@@ -5,8 +5,18 @@
 #include <optional>
 #include <array>
 
+/**
+ * @brief Exit status and combined stdout/stderr of a finished command
+ */
+struct CommandResult {
+    int exitCode = -1;      // -1 if the command could not be started or was killed
+    std::string output;
+    bool timedOut = false;
+};
+
 class GitUtils {
 public:
+    static CommandResult runWithTimeout(const std::string& cmd, int timeoutSeconds);
     static void configureSshForGitHub();
     static bool isGitRepo(const std::string& path);
     static std::optional<std::string> getCurrentBranch(const std::string& path);
@@ -2,26 +2,383 @@
  * @file github.cpp
  * @brief GitHub API client implementation
  * 
- * Provides functionality to interact with GitHub's REST API including:
+ * Provides functionality to interact with GitHub's REST and GraphQL APIs including:
  * - Authentication
  * - Repository creation, listing, and deletion
  * - Username retrieval with fallback to git config
  */
 
 #include "github.h"
+#include "config.h"
 #include "constants.h"
+#include "executor.h"
+#include "metrics.h"
+#include "parallel.h"
+#include "rate_limiter.h"
+#include "repo_index.h"
+#include "repo_list.h"
+#include "repo_parser.h"
+#include "response_cache.h"
+#include "trace.h"
+#include "transport.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <future>
 #include <iostream>
 #include <sstream>
+#include <strings.h>
+#include <thread>
 #include <nlohmann/json.hpp>
-#include <httplib.h>
 
 using json = nlohmann::json;
 
+namespace {
+
+/**
+ * @brief Decodes one page of /user/repos, reporting failures on stderr
+ */
+bool decodeRepoPage(std::string_view body, std::vector<RepoInfo>& out) {
+    std::string error;
+    if (!parseRepoPage(body, out, &error)) {
+        std::cerr << "listRepositories parse error: " << error << "\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes one page of /user/repos into a compact list; only the
+ *        page itself is ever held as RepoInfo
+ */
+bool decodeRepoPage(std::string_view body, RepoList& out) {
+    std::vector<RepoInfo> page;
+    if (!decodeRepoPage(body, page)) return false;
+    out.append(page);
+    return true;
+}
+
+/**
+ * @brief GraphQL query for one page of the viewer's repositories
+ * 
+ * Selects only the fields RepoInfo needs. Affiliations match the /user/repos
+ * defaults so both backends list the same repositories. The order does not:
+ * GraphQL cannot order by owner, so it lists by name across all owners where
+ * /user/repos sorts by full name (owner/name).
+ */
+std::string repositoriesQuery() {
+    return "query($cursor: String) { viewer { repositories(first: " +
+           std::to_string(constants::API_REPOS_PER_PAGE) + ", after: $cursor, "
+           "ownerAffiliations: [OWNER, COLLABORATOR, ORGANIZATION_MEMBER], "
+           "orderBy: {field: NAME, direction: ASC}) { "
+           "pageInfo { hasNextPage endCursor } "
+           "nodes { name description isPrivate url sshUrl updatedAt } } } }";
+}
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Phase boundaries of one HTTP attempt
+ *
+ * Boundaries the transport could not observe stay unset: connectedAt and
+ * handshakeAt with httplib, headersAt for httplib's non-GET requests.
+ */
+struct RequestTiming {
+    Clock::time_point queuedAt;
+    Clock::time_point sentAt;
+    Clock::time_point connectedAt;
+    Clock::time_point handshakeAt;
+    Clock::time_point headersAt;
+    Clock::time_point doneAt;
+    bool reused = false;
+    size_t bytes = 0;
+    size_t sentBytes = 0;
+    std::string wireBytes;  // Content-Length, when the server sent one
+};
+
+double millis(Clock::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+/**
+ * @brief Counts an attempt in the metrics, prints its phases in debug mode
+ *        and records them as trace spans
+ */
+void reportTiming(const std::string& method, const std::string& path, int status,
+                  int attempt, const RequestTiming& timing, bool debug) {
+    const Clock::time_point unset;
+    bool split = timing.headersAt != unset;
+    const char* connection = timing.reused ? "reused" : "new";
+    // Time to first byte counts from the end of the handshakes when those are known
+    Clock::time_point requestAt = timing.handshakeAt != unset ? timing.handshakeAt :
+                                  timing.connectedAt != unset ? timing.connectedAt : timing.sentAt;
+    
+    Metrics::instance().recordRequest(method, path, status, millis(timing.doneAt - timing.sentAt) / 1000.0,
+                                      timing.bytes, timing.sentBytes, attempt > 0);
+
+    if (debug) {
+        std::cerr << "[DEBUG] " << method << " " << path << " -> " << status << ", "
+                  << timing.bytes << " bytes in " << millis(timing.doneAt - timing.queuedAt) << " ms (wait "
+                  << millis(timing.sentAt - timing.queuedAt) << " ms, ";
+        if (timing.connectedAt != unset) {
+            std::cerr << "connect " << millis(timing.connectedAt - timing.sentAt) << " ms, ";
+        }
+        if (timing.handshakeAt != unset) {
+            std::cerr << "tls " << millis(timing.handshakeAt - (timing.connectedAt != unset ? timing.connectedAt : timing.sentAt))
+                      << " ms, ";
+        }
+        if (split) {
+            std::cerr << "ttfb " << millis(timing.headersAt - requestAt) << " ms, transfer "
+                      << millis(timing.doneAt - timing.headersAt) << " ms";
+        } else {
+            std::cerr << "exchange " << millis(timing.doneAt - timing.sentAt) << " ms";
+        }
+        std::cerr << ", " << connection << " connection)\n";
+    }
+
+    if (!Trace::enabled()) return;
+    auto& trace = Trace::instance();
+    Trace::Event request{"attempt " + std::to_string(attempt + 1), "http", timing.queuedAt, timing.doneAt};
+    request.numbers = {{"status", status}, {"bytes", static_cast<double>(timing.bytes)}};
+    request.strings = {{"connection", connection}};
+    if (!timing.wireBytes.empty()) request.strings.emplace_back("content_length", timing.wireBytes);
+    trace.record(std::move(request));
+
+    trace.record({"wait", "http.phase", timing.queuedAt, timing.sentAt});
+    if (timing.connectedAt != unset) {
+        trace.record({"connect", "http.phase", timing.sentAt, timing.connectedAt});
+    }
+    if (timing.handshakeAt != unset) {
+        trace.record({"tls", "http.phase", timing.connectedAt != unset ? timing.connectedAt : timing.sentAt,
+                      timing.handshakeAt});
+    }
+    if (split) {
+        // Without connect/tls phases, a new connection's handshakes are included here
+        Trace::Event ttfb{"ttfb", "http.phase", requestAt, timing.headersAt};
+        ttfb.strings = {{"connection", connection}};
+        trace.record(std::move(ttfb));
+        trace.record({"transfer", "http.phase", timing.headersAt, timing.doneAt});
+    } else {
+        Trace::Event exchange{"exchange", "http.phase", requestAt, timing.doneAt};
+        exchange.strings = {{"connection", connection}};
+        trace.record(std::move(exchange));
+    }
+}
+
+}  // namespace
+
+// ============================================================================
+// Pagination Helpers
+// ============================================================================
+
+/**
+ * @brief Extracts the API path for a relation from a Link header
+ * @param linkHeader Value of the Link response header
+ * @param rel Relation name, e.g. "next" or "last"
+ * @return Path and query (host stripped), or empty string if not present
+ */
+std::string parseLinkHeader(std::string_view linkHeader, const std::string& rel) {
+    size_t relPos = linkHeader.find("rel=\"" + rel + "\"");
+    if (relPos == std::string_view::npos) return "";
+    
+    size_t start = linkHeader.rfind('<', relPos);
+    if (start == std::string_view::npos) return "";
+    size_t end = linkHeader.find('>', start);
+    if (end == std::string_view::npos || end > relPos) return "";
+    
+    std::string url(linkHeader.substr(start + 1, end - start - 1));
+    size_t schemePos = url.find("://");
+    if (schemePos != std::string::npos) {
+        size_t pathPos = url.find('/', schemePos + 3);
+        return pathPos == std::string::npos ? "/" : url.substr(pathPos);
+    }
+    return url;
+}
+
+namespace {
+
+/**
+ * @brief Finds the value offset of the "page" query parameter (not per_page)
+ */
+size_t findPageParam(const std::string& path) {
+    for (size_t pos = path.find("page="); pos != std::string::npos; pos = path.find("page=", pos + 1)) {
+        if (pos > 0 && (path[pos - 1] == '?' || path[pos - 1] == '&')) {
+            return pos + 5;
+        }
+    }
+    return std::string::npos;
+}
+
+}  // namespace
+
+/**
+ * @brief Reads the page number from a paginated API path
+ * @return Page number, or 0 if the path has no page parameter
+ */
+int pageNumber(const std::string& path) {
+    size_t valuePos = findPageParam(path);
+    if (valuePos == std::string::npos) return 0;
+    try {
+        return std::stoi(path.substr(valuePos));
+    } catch (...) {
+        return 0;
+    }
+}
+
+/**
+ * @brief Returns a copy of a paginated API path pointing at another page
+ */
+std::string withPageNumber(const std::string& path, int page) {
+    size_t valuePos = findPageParam(path);
+    if (valuePos == std::string::npos) {
+        return path + (path.find('?') == std::string::npos ? "?" : "&") + "page=" + std::to_string(page);
+    }
+    size_t valueEnd = path.find('&', valuePos);
+    return path.substr(0, valuePos) + std::to_string(page) +
+           (valueEnd == std::string::npos ? "" : path.substr(valueEnd));
+}
+
+/**
+ * @brief Splits a scope header such as "repo, delete_repo" into scopes
+ */
+std::vector<std::string> parseScopeList(const std::string& header) {
+    std::vector<std::string> scopes;
+    std::istringstream stream(header);
+    std::string scope;
+    while (std::getline(stream, scope, ',')) {
+        size_t begin = scope.find_first_not_of(" \t");
+        size_t end = scope.find_last_not_of(" \t");
+        if (begin != std::string::npos) {
+            scopes.push_back(scope.substr(begin, end - begin + 1));
+        }
+    }
+    return scopes;
+}
+
 // ============================================================================
 // Constructors
 // ============================================================================
 
-GitHubClient::GitHubClient(const std::string& token) : token_(token) {}
+/**
+ * @brief Creates a client for the given token
+ * @param token Personal access token
+ * @param apiBase Scheme, host and optional port of the API, e.g. a local stand-in server
+ */
+GitHubClient::GitHubClient(const std::string& token, const std::string& apiBase)
+    : token_(token), apiBase_(apiBase), dataDir_(ConfigManager::dataDir()) {
+    transport_ = makeTransport(TransportKind::Httplib, transportConfig());
+    cache_ = std::make_unique<ResponseCache>(dataDir_ + "/" + constants::CACHE_DIR, token);
+    identityCache_ = std::make_unique<IdentityCache>(dataDir_, token);
+    limiter_ = std::make_unique<RateLimiter>(constants::API_MAX_CONNECTIONS, constants::API_MAX_CONCURRENCY);
+}
+
+GitHubClient::~GitHubClient() = default;
+
+/**
+ * @brief Connection settings shared by every transport backend
+ */
+TransportConfig GitHubClient::transportConfig() const {
+    TransportConfig config;
+    config.baseUrl = apiBase_;
+    config.maxConnections = constants::API_MAX_CONNECTIONS;
+    config.timeout = constants::API_TIMEOUT;
+    config.defaultHeaders = {
+        {"Authorization", "Bearer " + token_},
+        {"Accept", "application/vnd.github+json"},
+        {"X-GitHub-Api-Version", "2022-11-28"}
+    };
+    return config;
+}
+
+/**
+ * @brief Switches the HTTP backend
+ * 
+ * Call before the client is shared between threads; open connections of
+ * the previous backend are closed.
+ * 
+ * @param kind Backend to use
+ * @return false if this build does not include that backend
+ */
+bool GitHubClient::setTransport(TransportKind kind) {
+    auto transport = makeTransport(kind, transportConfig());
+    if (!transport) return false;
+    transport->setDebug(debug_);
+    transport_ = std::move(transport);
+    return true;
+}
+
+const char* GitHubClient::transportName() const {
+    return transport_->name();
+}
+
+/**
+ * @brief Enables debug output for connection handling
+ * @param debug true to log connection reuse to stderr
+ */
+void GitHubClient::setDebug(bool debug) {
+    debug_ = debug;
+    transport_->setDebug(debug);
+}
+
+/**
+ * @brief Returns the rate-limit budget seen so far
+ * 
+ * Bulk callers can use this to pace themselves before the limiter has to.
+ */
+RateLimitStatus GitHubClient::rateLimit() const {
+    return limiter_->status();
+}
+
+/**
+ * @brief Enables or disables the on-disk caches: the ETag cache for GET
+ *        requests and the cached identity behind the token
+ * @param enabled false to always download full responses and ask GET /user
+ */
+void GitHubClient::setCacheEnabled(bool enabled) {
+    if (!enabled) {
+        cache_.reset();
+        identityCache_.reset();
+    } else if (!cache_) {
+        cache_ = std::make_unique<ResponseCache>(dataDir_ + "/" + constants::CACHE_DIR, token_);
+        identityCache_ = std::make_unique<IdentityCache>(dataDir_, token_);
+    }
+}
+
+/**
+ * @brief Keeps the response cache, identity cache and index under dir
+ *        instead of ~/.gh-repo-create, e.g. a scratch directory in tests
+ * 
+ * Call before the index is first used; caches that are disabled stay disabled.
+ */
+void GitHubClient::setDataDir(const std::string& dir) {
+    dataDir_ = dir;
+    if (cache_) {
+        cache_ = std::make_unique<ResponseCache>(dataDir_ + "/" + constants::CACHE_DIR, token_);
+        identityCache_ = std::make_unique<IdentityCache>(dataDir_, token_);
+    }
+}
+
+/**
+ * @brief Changes the minimum spacing between create/update/delete calls
+ * 
+ * GitHub asks for about a second between content-creating requests; API
+ * stand-ins and load tests can lower it.
+ */
+void GitHubClient::setMutationInterval(std::chrono::milliseconds interval) {
+    limiter_->setMutationInterval(interval);
+}
+
+/**
+ * @brief Enables or disables gzip-compressed responses
+ * @param enabled false to ask for uncompressed bodies
+ * 
+ * Has no effect when built without zlib, which never requests compression.
+ */
+void GitHubClient::setCompressionEnabled(bool enabled) {
+    compression_ = enabled;
+}
 
 // ============================================================================
 // Authentication
@@ -29,23 +386,113 @@ GitHubClient::GitHubClient(const std::string& token) : token_(token) {}
 
 /**
  * @brief Authenticates with GitHub API using the stored token
+ * @param refresh true to always ask GET /user, e.g. for `--check`, which
+ *        must notice a token revoked since the identity was cached
  * @return true if authentication successful, false otherwise
  * 
- * Makes a request to /user endpoint to validate the token.
+ * Uses the identity cached by an earlier run with the same token when it is
+ * still fresh, otherwise makes a request to /user to validate the token.
  * On success, caches the username for future use.
  */
-bool GitHubClient::authenticate() {
-    auto [status, body] = request("GET", "/user");
-    if (status == 200) {
-        try {
-            auto data = json::parse(body);
-            username_ = data.value("login", "");
+bool GitHubClient::authenticate(bool refresh) {
+    std::lock_guard<std::mutex> lock(usernameMutex_);
+    return identify(refresh);
+}
+
+/**
+ * @brief Fills username_ and identity_ from the identity cache or GET /user
+ * @param refresh true to skip the identity cache and replace its entry
+ * @return true if the token belongs to a user
+ * 
+ * Call with usernameMutex_ held. A fresh answer from the API is written
+ * back to the identity cache along with the token's scopes and expiry; the
+ * entry is dropped again as soon as any request gets a 401. A failed
+ * refresh also forgets the identity held in memory.
+ */
+bool GitHubClient::identify(bool refresh) {
+    if (refresh) {
+        username_.reset();
+        identity_.reset();
+    } else if (identityCache_) {
+        if (auto cached = identityCache_->load()) {
+            if (debug_) {
+                std::cerr << "[DEBUG] Identity " << cached->login << " from cache, skipping GET /user\n";
+            }
+            username_ = cached->login;
+            identity_ = std::move(cached);
             return true;
-        } catch (...) {
-            return false;
         }
     }
-    return false;
+    
+    return storeIdentity(request("GET", "/user"));
+}
+
+/**
+ * @brief Asks GET /user once, within a deadline, for `--check`
+ * @param timeout Seconds allowed for the exchange
+ * @param status Set to the response status; -1 if no answer came in time
+ * @return true if the token belongs to a user
+ * 
+ * Unlike authenticate(true), the request is not retried, so a hung API
+ * releases the client (and the identity lock) after timeout seconds
+ * instead of after every backoff attempt.
+ */
+bool GitHubClient::probeIdentity(int timeout, int& status) {
+    std::lock_guard<std::mutex> lock(usernameMutex_);
+    username_.reset();
+    identity_.reset();
+    RequestOptions options;
+    options.timeout = timeout;
+    options.maxRetries = 0;
+    ApiResponse res = request("GET", "/user", "", options);
+    status = res.status();
+    return storeIdentity(res);
+}
+
+/**
+ * @brief Fills username_ and identity_ from a GET /user response
+ * @return true if the response names the token's user
+ * 
+ * Call with usernameMutex_ held.
+ */
+bool GitHubClient::storeIdentity(const ApiResponse& res) {
+    if (res.status() != 200) {
+        return false;
+    }
+    
+    CachedIdentity identity;
+    try {
+        identity.login = json::parse(res.body()).value("login", "");
+    } catch (const std::exception& e) {
+        std::cerr << "Error parsing username response: " << e.what() << "\n";
+        return false;
+    }
+    std::string_view scopes = res.header("X-OAuth-Scopes");
+    // A null view means no header at all; an empty value means a token without scopes
+    identity.scopesReported = scopes.data() != nullptr;
+    identity.scopes = scopes;
+    identity.acceptedScopes = res.header("X-Accepted-OAuth-Scopes");
+    identity.expiresAt = res.header("GitHub-Authentication-Token-Expiration");
+    identity.fetchedAt = std::time(nullptr);
+    if (identity.login.empty()) {
+        std::cerr << "Warning: API returned empty username\n";
+    } else if (identityCache_) {
+        identityCache_->store(identity);
+    }
+    username_ = identity.login;
+    identity_ = std::move(identity);
+    return true;
+}
+
+/**
+ * @brief Opens a pooled connection ahead of time
+ * @return true if the API answered
+ * 
+ * Pays for the TCP and TLS handshake before it is needed and seeds the rate
+ * limiter's budget. GET /rate_limit does not count against the rate limit.
+ */
+bool GitHubClient::warmUp() {
+    return request("GET", "/rate_limit").status() == 200;
 }
 
 /**
@@ -54,35 +501,32 @@ bool GitHubClient::authenticate() {
  * 
  * Priority:
  * 1. Cached username from previous authentication
- * 2. Fetch from GitHub API /user endpoint
+ * 2. Identity cached on disk by an earlier run, or the GitHub API /user endpoint
  * 3. Fallback to git global config (github.user)
  */
 std::string GitHubClient::getUsername() {
+    // Held across the lookup so concurrent callers fetch the username only once
+    std::lock_guard<std::mutex> lock(usernameMutex_);
+    
     // Return cached username if available
     if (username_.has_value() && !username_->empty()) {
         return *username_;
     }
     
-    // Try to fetch from GitHub API
-    auto [status, body] = request("GET", "/user");
-    if (status == 200) {
-        try {
-            auto data = json::parse(body);
-            username_ = data.value("login", "");
-            if (username_->empty()) {
-                std::cerr << "Warning: API returned empty username\n";
-            }
-            return *username_;
-        } catch (const std::exception& e) {
-            std::cerr << "Error parsing username response: " << e.what() << "\n";
-        }
+    // Try the identity cache, then the GitHub API
+    if (identify()) {
+        return *username_;
     }
     
     // Fallback to git config
+    Trace::Span span("git config --global github.user", "git");
+    auto spawnedAt = Clock::now();
     FILE* pipe = popen("git config --global github.user 2>/dev/null", "r");
     if (pipe) {
         char buffer[256] = {0};
-        if (fgets(buffer, sizeof(buffer), pipe)) {
+        bool gotLine = fgets(buffer, sizeof(buffer), pipe) != nullptr;
+        Metrics::instance().recordSubprocess("git config", millis(Clock::now() - spawnedAt) / 1000.0);
+        if (gotLine) {
             std::string gitUser = buffer;
             // Trim whitespace
             gitUser.erase(gitUser.find_last_not_of(" \n\r") + 1);
@@ -99,6 +543,40 @@ std::string GitHubClient::getUsername() {
     return username_.value_or("");
 }
 
+/**
+ * @brief Returns the scopes reported when the token was authenticated
+ * @return Scopes, or nullopt if authenticate() has not succeeded
+ * 
+ * Costs no request: the scopes come with the /user response (or the
+ * identity cache) that authenticate() already used.
+ */
+std::optional<TokenScopes> GitHubClient::tokenScopes() {
+    std::lock_guard<std::mutex> lock(usernameMutex_);
+    if (!identity_) {
+        return std::nullopt;
+    }
+    TokenScopes scopes;
+    scopes.reported = identity_->scopesReported;
+    scopes.granted = parseScopeList(identity_->scopes);
+    scopes.accepted = parseScopeList(identity_->acceptedScopes);
+    return scopes;
+}
+
+bool TokenScopes::has(const std::string& scope) const {
+    for (const auto& s : granted) {
+        if (s == scope) return true;
+        // "repo" grants all repo sub-scopes, "admin:org" grants "write:org" and "read:org", ...
+        if (scope == "public_repo" || scope.rfind("repo:", 0) == 0) {
+            if (s == "repo") return true;
+        }
+        size_t colon = scope.find(':');
+        if (colon != std::string::npos && s == "admin" + scope.substr(colon)) return true;
+        if (colon != std::string::npos && scope.compare(0, colon, "read") == 0 &&
+            s == "write" + scope.substr(colon)) return true;
+    }
+    return false;
+}
+
 // ============================================================================
 // Repository Operations
 // ============================================================================
@@ -116,87 +594,402 @@ bool GitHubClient::createRepository(const RepoInfo& repo) {
         {"auto_init", true}
     };
     
-    auto [status, response] = request("POST", "/user/repos", body.dump());
-    return status == 201;
+    ApiResponse res = request("POST", "/user/repos", body.dump());
+    if (res.status() != 201) return false;
+    
+    std::string owner;
+    {
+        std::lock_guard<std::mutex> lock(usernameMutex_);
+        owner = username_.value_or("");
+    }
+    if (!owner.empty()) {
+        rememberExists(owner, repo.name, true);
+    }
+    
+    // Keep the local index current without waiting for the next sync
+    RepoInfo created;
+    if (parseRepoObject(res.body(), created)) {
+        updateIndex({created}, {});
+    }
+    return true;
+}
+
+/**
+ * @brief Changes the description and/or visibility of a repository
+ * @param name Repository name
+ * @param description New description, or nullopt to leave unchanged
+ * @param isPrivate New visibility, or nullopt to leave unchanged
+ * @return true if the update succeeded
+ */
+bool GitHubClient::updateRepository(const std::string& name,
+                                    const std::optional<std::string>& description,
+                                    std::optional<bool> isPrivate) {
+    std::string owner = getUsername();
+    if (owner.empty() || name.empty()) return false;
+    
+    json body = json::object();
+    if (description) body["description"] = *description;
+    if (isPrivate) body["private"] = *isPrivate;
+    
+    ApiResponse res = request("PATCH", "/repos/" + owner + "/" + name, body.dump());
+    if (res.status() != 200) return false;
+    
+    RepoInfo updated;
+    if (parseRepoObject(res.body(), updated)) {
+        updateIndex({updated}, {});
+    }
+    return true;
 }
 
 /**
  * @brief Checks if a repository exists in the user's account
  * @param name Repository name to check
  * @return true if repository exists, false otherwise
+ * 
+ * Looks the repository up directly with GET /repos/{owner}/{name}. Answers
+ * are cached for constants::EXISTS_CACHE_TTL seconds, both positive and
+ * negative, so repeated checks of the same name cost nothing.
  */
 bool GitHubClient::repositoryExists(const std::string& name) {
-    auto [status, body] = request("GET", "/user/repos?per_page=" + std::to_string(constants::API_REPOS_PER_PAGE));
-    if (status == 200) {
-        try {
-            auto repos = json::parse(body);
-            for (const auto& r : repos) {
-                if (r.value("name", "") == name) {
-                    return true;
-                }
-            }
-        } catch (...) {}
+    std::string owner = getUsername();
+    if (owner.empty() || name.empty()) return false;
+    return lookupRepository(owner, name);
+}
+
+/**
+ * @brief Checks many candidate names at once
+ * @param names Repository names to check
+ * @return Map from each name to whether it exists
+ * 
+ * Uncached names are looked up concurrently, bounded by the connection pool size.
+ */
+std::unordered_map<std::string, bool> GitHubClient::repositoriesExist(const std::vector<std::string>& names) {
+    std::unordered_map<std::string, bool> result;
+    std::string owner = getUsername();
+    if (owner.empty()) {
+        for (const auto& name : names) result[name] = false;
+        return result;
     }
-    return false;
+    
+    std::vector<char> exists(names.size(), 0);
+    parallelFor(names.size(), constants::API_MAX_CONNECTIONS, [&](size_t i) {
+        exists[i] = !names[i].empty() && lookupRepository(owner, names[i]);
+    });
+    for (size_t i = 0; i < names.size(); i++) {
+        result[names[i]] = exists[i] != 0;
+    }
+    return result;
+}
+
+/**
+ * @brief Cached GET /repos/{owner}/{name}
+ * 
+ * Only 200 counts as existing. A 301 means the name is a redirect left by
+ * a rename, which GitHub lets you reuse. Errors other than 404 are not
+ * cached, so a transient failure does not stick.
+ */
+bool GitHubClient::lookupRepository(const std::string& owner, const std::string& name) {
+    std::string key = owner + "/" + name;
+    std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+    auto now = std::chrono::steady_clock::now();
+    
+    {
+        std::lock_guard<std::mutex> lock(existsMutex_);
+        auto it = existsCache_.find(key);
+        if (it != existsCache_.end() && it->second.second > now) {
+            return it->second.first;
+        }
+    }
+    
+    // existsCache_ answers repeats within its TTL: no ETag cache file per name looked up
+    RequestOptions options;
+    options.cacheable = false;
+    int status = request("GET", "/repos/" + owner + "/" + name, "", options).status();
+    if (status == 200 || status == 404 || status == 301) {
+        rememberExists(owner, name, status == 200);
+    }
+    return status == 200;
+}
+
+/**
+ * @brief Records a known existence answer in the lookup cache
+ */
+void GitHubClient::rememberExists(const std::string& owner, const std::string& name, bool exists) {
+    std::string key = owner + "/" + name;
+    std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+    auto expiry = std::chrono::steady_clock::now() + std::chrono::seconds(constants::EXISTS_CACHE_TTL);
+    std::lock_guard<std::mutex> lock(existsMutex_);
+    existsCache_[key] = {exists, expiry};
 }
 
 /**
  * @brief Lists all repositories for the authenticated user
  * @return Vector of RepoInfo structs containing repository details
  * 
- * Handles pagination automatically by following the Link header.
- * Each page requests up to 100 repositories.
+ * Uses the GraphQL API when the token allows it, since it returns only the
+ * fields RepoInfo needs. Otherwise falls back to the REST listing, where each
+ * page requests up to 100 repositories. When the first response carries
+ * a rel="last" link, the remaining pages are fetched concurrently (bounded by
+ * setMaxParallelPages) and reassembled in page order. Otherwise rel="next" is
+ * followed, fetching page N+1 while page N is being parsed.
+ * 
+ * If a page still fails after retries, the repositories from the pages
+ * before it are returned and a warning is printed.
  */
 std::vector<RepoInfo> GitHubClient::listRepositories() {
-    std::vector<RepoInfo> repos;
-    std::string nextPage = "/user/repos?per_page=" + std::to_string(constants::API_REPOS_PER_PAGE);
+    return listRepositoriesCompact().toVector();
+}
+
+/**
+ * @brief Lists all repositories into an arena-backed RepoList
+ * @param onPage Called on this thread as each page is added, in listing
+ *        order, e.g. to print repositories before pagination finishes
+ * 
+ * Same listing as listRepositories(), for accounts where a RepoInfo per
+ * repository is too much: pages are decoded one at a time and packed into
+ * the list as they arrive.
+ */
+RepoList GitHubClient::listRepositoriesCompact(const RepoPageCallback& onPage) {
+    RepoList repos;
+    if (!fetchRepositories(repos, onPage) && !repos.empty()) {
+        std::cerr << "Warning: repository listing is incomplete (" << repos.size() << " repositories)\n";
+    }
+    return repos;
+}
+
+/**
+ * @brief Lists the organizations the authenticated user belongs to
+ * @return Organization logins, in the order GitHub returns them
+ * 
+ * Organizations that restrict OAuth app access are still listed; their
+ * repositories may then come back empty or refused.
+ */
+std::vector<std::string> GitHubClient::listOrganizations() {
+    std::vector<std::string> orgs;
+    std::string path = "/user/orgs?per_page=" + std::to_string(constants::API_REPOS_PER_PAGE);
+    while (!path.empty()) {
+        ApiResponse res = request("GET", path);
+        if (res.status() != 200) {
+            std::cerr << "Error: Could not list organizations (HTTP " << res.status() << ")\n";
+            break;
+        }
+        std::string error;
+        if (!parseOrgPage(res.body(), orgs, &error)) {
+            std::cerr << "listOrganizations parse error: " << error << "\n";
+            break;
+        }
+        path = parseLinkHeader(res.header("Link"), "next");
+    }
+    return orgs;
+}
+
+/**
+ * @brief Lists the repositories of several organizations as one RepoList
+ * @param orgs Organization logins
+ * @param onPage Called with each organization's own list as its pages are
+ *        added; calls are serialized but come from several threads, in
+ *        arrival order across organizations
+ * @return Every organization's repositories, grouped in the order of orgs;
+ *         RepoList::owner() tells them apart
+ * 
+ * Organizations are fetched concurrently (constants::API_MAX_PARALLEL_OWNERS
+ * at a time), each with the parallel REST pagination of /orgs/{org}/repos,
+ * over the client's shared transport and rate limiter. An organization that
+ * cannot be listed completely is reported on stderr; what was fetched of it
+ * is kept.
+ */
+RepoList GitHubClient::listOrganizationRepositories(const std::vector<std::string>& orgs,
+                                                    const RepoPageCallback& onPage) {
+    std::mutex pageMutex;
+    RepoPageCallback orgPage;
+    if (onPage) {
+        orgPage = [&](const RepoList& list, size_t from) {
+            std::lock_guard<std::mutex> lock(pageMutex);
+            onPage(list, from);
+        };
+    }
+    
+    std::vector<RepoList> lists(orgs.size());
+    std::vector<char> ok(orgs.size(), 0);
+    parallelFor(orgs.size(), constants::API_MAX_PARALLEL_OWNERS, [&](size_t i) {
+        Trace::Span span("list " + orgs[i], "list");
+        ok[i] = fetchRepositoriesRest(lists[i], "/orgs/" + orgs[i] + "/repos?per_page=" +
+                                                std::to_string(constants::API_REPOS_PER_PAGE), orgPage);
+    });
     
-    while (!nextPage.empty()) {
-        auto [status, body, headers] = requestWithHeaders("GET", nextPage);
-        if (status != 200) break;
+    RepoList repos;
+    for (size_t i = 0; i < orgs.size(); i++) {
+        if (!ok[i]) {
+            std::cerr << "Warning: repository listing of " << orgs[i] << " is incomplete ("
+                      << lists[i].size() << " repositories)\n";
+        }
+        repos.append(lists[i]);
+        lists[i] = RepoList();
+    }
+    if (debug_) {
+        std::cerr << "[DEBUG] Listed " << repos.size() << " repositories from " << orgs.size()
+                  << " organizations\n";
+    }
+    return repos;
+}
+
+/**
+ * @brief Fetches every repository into repos, preferring GraphQL
+ * @param onPage Called as pages are added, in listing order
+ * @return true only if all pages were fetched and parsed
+ * 
+ * GraphQL trades the REST path's parallel pages and ETag revalidation for
+ * much smaller pages: cursors make its pages sequential, and POST responses
+ * are not cached. If the first GraphQL page is refused (e.g. the token
+ * cannot use GraphQL), GraphQL is not tried again by this client. A GraphQL listing that fails
+ * after onPage has seen some of it is not redone over REST, which would
+ * hand the same repositories to onPage twice.
+ */
+bool GitHubClient::fetchRepositories(RepoList& repos, const RepoPageCallback& onPage) {
+    if (graphqlEnabled_) {
+        size_t before = repos.size();
+        bool refused = false;
+        if (fetchRepositoriesGraphQL(repos, refused, onPage)) return true;
+        if (onPage && repos.size() > before) return false;
         
-        try {
-            auto data = json::parse(body);
-            if (!data.is_array()) {
-                std::cerr << "listRepositories: response is not an array\n";
-                break;
-            }
-            for (const auto& r : data) {
-                RepoInfo info;
-                info.name = r.value("name", "");
-                // Handle null descriptions safely
-                if (r.contains("description") && !r["description"].is_null()) {
-                    info.description = r["description"].get<std::string>();
-                }
-                info.isPrivate = r.value("private", false);
-                info.htmlUrl = r.value("html_url", "");
-                repos.push_back(info);
+        repos.truncate(before);
+        if (refused) {
+            graphqlEnabled_ = false;
+        }
+        if (debug_) {
+            std::cerr << "[DEBUG] GraphQL listing failed, falling back to REST\n";
+        }
+    }
+    return fetchRepositoriesRest(repos, "/user/repos?per_page=" + std::to_string(constants::API_REPOS_PER_PAGE),
+                                 onPage);
+}
+
+/**
+ * @brief Fetches every repository through the GraphQL API, following cursors
+ * @param refused Set when the first page was answered but unusable
+ * @return true only if all pages were fetched and parsed
+ */
+bool GitHubClient::fetchRepositoriesGraphQL(RepoList& repos, bool& refused, const RepoPageCallback& onPage) {
+    std::string query = repositoriesQuery();
+    std::string cursor;
+    std::vector<RepoInfo> nodes;
+    for (bool first = true; ; first = false) {
+        json payload = {
+            {"query", query},
+            {"variables", {{"cursor", cursor.empty() ? json(nullptr) : json(cursor)}}}
+        };
+        ApiResponse res = request("POST", constants::GRAPHQL_PATH, payload.dump());
+        if (res.status() != 200) {
+            refused = first && res.status() != -1;
+            return false;
+        }
+        
+        GraphQLPageInfo page;
+        std::string error;
+        nodes.clear();
+        if (!parseGraphQLRepoPage(res.body(), nodes, page, &error)) {
+            if (debug_) {
+                std::cerr << "[DEBUG] GraphQL listing error: " << error << "\n";
             }
-        } catch (const std::exception& e) {
-            std::cerr << "listRepositories parse error: " << e.what() << "\n";
-            break;
+            refused = first;
+            return false;
         }
+        size_t from = repos.size();
+        repos.append(nodes);
+        if (onPage) onPage(repos, from);
+        if (!page.hasNextPage || page.endCursor.empty()) return true;
+        cursor = std::move(page.endCursor);
+    }
+}
+
+/**
+ * @brief Fetches every page of a REST repository listing into repos
+ * @param firstPage First page, e.g. /user/repos or /orgs/{org}/repos with per_page
+ * @param onPage Called on this thread as pages are added, in page order
+ * @return true only if all pages were fetched and parsed
+ */
+bool GitHubClient::fetchRepositoriesRest(RepoList& repos, const std::string& firstPage,
+                                         const RepoPageCallback& onPage) {
+    ApiResponse res = request("GET", firstPage);
+    if (res.status() != 200) return false;
+    
+    std::string lastPage = parseLinkHeader(res.header("Link"), "last");
+    int lastPageNumber = pageNumber(lastPage);
+    
+    if (lastPageNumber > 1) {
+        // Known page count: fan out pages 2..last while page 1 is parsed here,
+        // then add each page as soon as it and the pages before it are in
+        size_t remaining = static_cast<size_t>(lastPageNumber - 1);
+        std::vector<RepoList> pages(remaining);
+        std::vector<char> ok(remaining, 0);
+        std::vector<char> done(remaining, 0);
+        std::mutex doneMutex;
+        std::condition_variable doneChanged;
         
-        // Parse pagination Link header
-        nextPage.clear();
-        auto linkIt = headers.find("Link");
-        if (linkIt != headers.end()) {
-            std::string linkHeader = linkIt->second;
-            size_t nextPos = linkHeader.find("rel=\"next\"");
-            if (nextPos != std::string::npos) {
-                size_t start = linkHeader.rfind("<", nextPos);
-                size_t end = linkHeader.find(">", nextPos);
-                if (start != std::string::npos && end != std::string::npos) {
-                    std::string url = linkHeader.substr(start + 1, end - start - 1);
-                    size_t queryPos = url.find("/user/repos");
-                    if (queryPos != std::string::npos) {
-                        nextPage = url.substr(queryPos);
-                    }
+        auto fanOut = std::async(std::launch::async, [&]() {
+            parallelFor(remaining, maxParallelPages_, [&](size_t i) {
+                std::string path = withPageNumber(lastPage, static_cast<int>(i) + 2);
+                ApiResponse page = request("GET", path);
+                ok[i] = page.status() == 200 && decodeRepoPage(page.body(), pages[i]);
+                {
+                    std::lock_guard<std::mutex> lock(doneMutex);
+                    done[i] = 1;
                 }
+                doneChanged.notify_all();
+            });
+        });
+        
+        size_t from = repos.size();
+        bool complete = decodeRepoPage(res.body(), repos);
+        if (complete && onPage) onPage(repos, from);
+        
+        for (size_t i = 0; complete && i < remaining; i++) {
+            {
+                std::unique_lock<std::mutex> lock(doneMutex);
+                doneChanged.wait(lock, [&]() { return done[i] != 0; });
+            }
+            if (!ok[i]) {
+                std::cerr << "listRepositories: failed to fetch page " << (i + 2)
+                          << " of " << lastPageNumber << "\n";
+                complete = false;
+                break;
             }
+            from = repos.size();
+            repos.append(pages[i]);
+            pages[i] = RepoList();
+            if (onPage) onPage(repos, from);
         }
+        fanOut.get();
+        return complete;
+    }
+    
+    // No page count: follow rel="next", overlapping the next fetch with parsing
+    std::string nextPage = parseLinkHeader(res.header("Link"), "next");
+    while (true) {
+        std::future<ApiResponse> pending;
+        if (!nextPage.empty()) {
+            pending = std::async(std::launch::async, [this, nextPage]() {
+                return request("GET", nextPage);
+            });
+        }
+        
+        size_t from = repos.size();
+        bool parsed = decodeRepoPage(res.body(), repos);
+        if (parsed && onPage) onPage(repos, from);
+        if (!pending.valid()) return parsed;
+        
+        res = pending.get();
+        if (!parsed || res.status() != 200) return false;
+        nextPage = parseLinkHeader(res.header("Link"), "next");
     }
-    return repos;
+}
+
+/**
+ * @brief Sets how many repository pages are fetched concurrently
+ * @param maxParallel Upper bound on in-flight page requests (minimum 1)
+ */
+void GitHubClient::setMaxParallelPages(size_t maxParallel) {
+    maxParallelPages_ = maxParallel == 0 ? 1 : maxParallel;
 }
 
 /**
@@ -212,59 +1005,307 @@ bool GitHubClient::deleteRepository(const std::string& name) {
         std::cerr << "Error: Unable to determine GitHub username\n";
         return false;
     }
-    auto [status, body] = request("DELETE", "/repos/" + owner + "/" + name);
-    return status == 204;
+    if (request("DELETE", "/repos/" + owner + "/" + name).status() != 204) return false;
+    
+    rememberExists(owner, name, false);
+    updateIndex({}, {{owner, name}});
+    return true;
 }
 
 // ============================================================================
-// HTTP Request Helpers
+// Local Repository Index
 // ============================================================================
 
 /**
- * @brief Makes an HTTP request to GitHub API
- * @param method HTTP method (GET, POST, DELETE)
- * @param path API endpoint path
- * @param body Request body for POST requests
- * @return Pair of status code and response body
+ * @brief Applies a successful create/update/delete to the index, if one is loaded
+ * 
+ * Serialized so bulk operations running on several threads can call it.
+ */
+void GitHubClient::updateIndex(const std::vector<RepoInfo>& changed, const std::vector<RepoKey>& removed) {
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    if (repoIndex().loaded()) {
+        repoIndex().merge(changed, removed);
+    }
+}
+
+/**
+ * @brief Returns the on-disk repository index for this token
+ * 
+ * The index is mapped lazily on first use. It may be empty (not loaded)
+ * until syncIndex() has completed once. Views into it are invalidated when
+ * another thread syncs the index or creates, updates or deletes a repository.
+ */
+RepoIndex& GitHubClient::repoIndex() {
+    std::call_once(indexOnce_, [this]() {
+        std::string path = dataDir_ + "/" + constants::INDEX_FILE_PREFIX +
+                           sha256Hex(token_).substr(0, 16) + ".bin";
+        index_ = std::make_unique<RepoIndex>(path);
+        index_->load();
+    });
+    return *index_;
+}
+
+/**
+ * @brief Brings the local repository index up to date
+ * @param forceFull Rebuild from a full listing instead of syncing incrementally
+ * @return true if the index now reflects the API, false if the API failed
+ * 
+ * An incremental sync walks /user/repos?sort=updated newest first and stops
+ * at the first repository older than the newest one already indexed, which
+ * usually means a single page. Incremental syncs cannot see repositories
+ * deleted elsewhere, so a full listing is done when the index is missing or
+ * older than constants::INDEX_FULL_SYNC_INTERVAL.
+ */
+bool GitHubClient::syncIndex(bool forceFull) {
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    RepoIndex& index = repoIndex();
+    std::int64_t now = static_cast<std::int64_t>(std::time(nullptr));
+    
+    if (forceFull || !index.loaded() || now - index.fullSyncTime() > constants::INDEX_FULL_SYNC_INTERVAL) {
+        RepoList repos;
+        if (!fetchRepositories(repos)) return false;
+        return index.replace(repos.toVector(), now);
+    }
+    
+    std::string newest = index.newestUpdatedAt();
+    std::vector<RepoInfo> changed;
+    std::string path = "/user/repos?sort=updated&direction=desc&per_page=" +
+                       std::to_string(constants::API_REPOS_PER_PAGE);
+    while (!path.empty()) {
+        ApiResponse res = request("GET", path);
+        if (res.status() != 200) return false;
+        
+        std::vector<RepoInfo> page;
+        if (!decodeRepoPage(res.body(), page)) return false;
+        
+        bool reachedIndexed = false;
+        for (auto& repo : page) {
+            if (repo.updatedAt < newest) {
+                reachedIndexed = true;
+                break;
+            }
+            changed.push_back(std::move(repo));
+        }
+        if (reachedIndexed) break;
+        
+        path = parseLinkHeader(res.header("Link"), "next");
+    }
+    
+    if (debug_) {
+        std::cerr << "[DEBUG] Index sync: " << changed.size() << " repositories updated since " << newest << "\n";
+    }
+    return index.merge(changed, {});
+}
+
+// ============================================================================
+// Asynchronous API
+// ============================================================================
+
+/**
+ * @brief Returns the executor behind the *Async methods, starting it on first use
+ * 
+ * The rate limiter still bounds how many requests are on the wire, so the
+ * executor's threads mostly wait; they let callers overlap whole operations.
  */
-std::pair<int, std::string> GitHubClient::request(const std::string& method, 
-                                                    const std::string& path,
-                                                    const std::string& body) {
-    auto [status, response, headers] = requestWithHeaders(method, path, body);
-    return {status, response};
+Executor& GitHubClient::executor() {
+    std::call_once(executorOnce_, [this]() {
+        executor_ = std::make_unique<Executor>(constants::API_ASYNC_THREADS);
+    });
+    return *executor_;
+}
+
+std::future<bool> GitHubClient::authenticateAsync(bool refresh) {
+    return executor().submit([this, refresh]() { return authenticate(refresh); });
+}
+
+std::future<bool> GitHubClient::warmUpAsync() {
+    return executor().submit([this]() { return warmUp(); });
+}
+
+std::future<std::string> GitHubClient::getUsernameAsync() {
+    return executor().submit([this]() { return getUsername(); });
+}
+
+std::future<bool> GitHubClient::createRepositoryAsync(const RepoInfo& repo) {
+    return executor().submit([this, repo]() { return createRepository(repo); });
+}
+
+std::future<bool> GitHubClient::updateRepositoryAsync(const std::string& name,
+                                                      const std::optional<std::string>& description,
+                                                      std::optional<bool> isPrivate) {
+    return executor().submit([this, name, description, isPrivate]() {
+        return updateRepository(name, description, isPrivate);
+    });
+}
+
+std::future<bool> GitHubClient::repositoryExistsAsync(const std::string& name) {
+    return executor().submit([this, name]() { return repositoryExists(name); });
+}
+
+std::future<std::unordered_map<std::string, bool>>
+GitHubClient::repositoriesExistAsync(const std::vector<std::string>& names) {
+    return executor().submit([this, names]() { return repositoriesExist(names); });
+}
+
+std::future<std::vector<RepoInfo>> GitHubClient::listRepositoriesAsync() {
+    return executor().submit([this]() { return listRepositories(); });
+}
+
+std::future<bool> GitHubClient::deleteRepositoryAsync(const std::string& name) {
+    return executor().submit([this, name]() { return deleteRepository(name); });
 }
 
+std::future<bool> GitHubClient::syncIndexAsync(bool forceFull) {
+    return executor().submit([this, forceFull]() { return syncIndex(forceFull); });
+}
+
+// ============================================================================
+// HTTP Request Helpers
+// ============================================================================
+
 /**
- * @brief Makes an HTTP request with full header response
- * @param method HTTP method
+ * @brief Makes a request to the GitHub API
+ * 
+ * Requests go through the configured Transport (see setTransport), which
+ * keeps connections alive, so only the first request on each connection
+ * pays for the TCP and TLS handshake.
+ * 
+ * Every attempt is admitted by the rate limiter. Rate-limited responses are
+ * retried after the server's Retry-After (or reset) plus jitter; network
+ * errors and 502/503/504 are retried with exponential backoff for GETs and
+ * GraphQL queries.
+ * 
+ * When built with zlib, responses are requested gzip-compressed (JSON
+ * listings shrink about 10:1) unless setCompressionEnabled(false) was called.
+ * 
+ * GET responses carrying an ETag are cached on disk unless options.cacheable
+ * is false. Later GETs of the same path send If-None-Match, and a 304 reply
+ * is answered from the cache as a 200 with the cached body and Link header. A 401 drops the cached identity.
+ * 
+ * Each attempt is timed in phases: waiting for a rate-limit permit (and,
+ * with httplib, a connection), connect and TLS where the transport reports
+ * them, time to the response headers and body transfer. Every attempt is
+ * counted in Metrics;
+ * phases are printed in debug mode and recorded as trace spans when tracing
+ * is enabled.
+ * 
+ * The transport's response is moved into the result, not copied: callers
+ * parse the body and read headers in place.
+ * 
+ * @param method HTTP method (GET, POST, PATCH, DELETE)
  * @param path API endpoint path
  * @param body Request body
- * @return Tuple of status code, response body, and headers
- */
-std::tuple<int, std::string, std::unordered_map<std::string, std::string>> 
-GitHubClient::requestWithHeaders(const std::string& method, 
-                                    const std::string& path,
-                                    const std::string& body) {
-    httplib::Client cli(apiBase_);
-    cli.set_default_headers({
-        {"Authorization", "Bearer " + token_},
-        {"Accept", "application/vnd.github+json"},
-        {"X-GitHub-Api-Version", "2022-11-28"}
-    });
+ * @param options Per-attempt timeout and retry limit, if not the defaults
+ * @return Final response; status -1 if no response was received
+ */
+ApiResponse GitHubClient::request(const std::string& method,
+                                  const std::string& path,
+                                  const std::string& body,
+                                  const RequestOptions& options) {
+    bool isGet = method == "GET";
+    // GraphQL queries are POSTs but read-only: no mutation spacing, safe to retry
+    bool readOnly = isGet || path == constants::GRAPHQL_PATH;
+    std::optional<CachedResponse> cached;
+    HttpRequest request{method, path, {}, body};
+    request.timeout = options.timeout;
+    bool useCache = isGet && cache_ && options.cacheable;
+    if (useCache) {
+        cached = cache_->load(path);
+        if (cached) {
+            request.headers.emplace_back("If-None-Match", cached->etag);
+        }
+    }
     
-    auto res = method == "GET" ? cli.Get(path) :
-               method == "POST" ? cli.Post(path, body, "application/json") :
-               cli.Delete(path);
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+    // The transport inflates gzip bodies transparently; "identity" opts out
+    request.headers.emplace_back("Accept-Encoding", compression_ ? "gzip" : "identity");
+#endif
     
-    if (!res) {
-        return {-1, "Network error", {}};
+    Trace::Span span(method + " " + path, "http");
+    HttpResponse res;
+    int attempt = 0;
+    for (; ; attempt++) {
+        RequestTiming timing;
+        timing.queuedAt = Clock::now();
+        timing.sentBytes = body.size();
+        {
+            auto permit = limiter_->acquire(!readOnly);
+            res = transport_->send(request);
+            timing.doneAt = Clock::now();
+        }
+        timing.sentAt = res.sentAt == Clock::time_point() ? timing.queuedAt : res.sentAt;
+        timing.connectedAt = res.connectedAt;
+        timing.handshakeAt = res.handshakeAt;
+        timing.headersAt = res.headersAt;
+        timing.reused = res.reused;
+        timing.bytes = res.body.size();
+        timing.wireBytes = res.header("Content-Length");
+        
+        int status = res.status;
+        reportTiming(method, path, status, attempt, timing, debug_);
+        RateLimitHeaders limits;
+        limits.limit = res.header("X-RateLimit-Limit");
+        limits.remaining = res.header("X-RateLimit-Remaining");
+        limits.reset = res.header("X-RateLimit-Reset");
+        limits.retryAfter = res.header("Retry-After");
+        limits.resource = res.header("X-RateLimit-Resource");
+        auto retryIn = limiter_->record(status, limits, res.body, readOnly, attempt);
+        if (!retryIn || attempt >= options.maxRetries) break;
+        
+        if (debug_) {
+            std::cerr << "[DEBUG] " << method << " " << path << " returned " << status
+                      << ", retrying in " << retryIn->count() << " ms\n";
+        }
+        Trace::Span backoff("backoff", "http.phase");
+        std::this_thread::sleep_for(*retryIn);
+    }
+    
+    if (useCache) {
+        Metrics::instance().recordCacheLookup(cached && res.status == 304);
+    }
+    if (res.status == 401 && identityCache_) {
+        // The token was revoked or expired: the next authenticate() asks GET /user again
+        identityCache_->invalidate();
+    }
+    span.set("attempts", attempt + 1);
+    span.set("status", res.status);
+    if (res.status == -1) {
+        span.set("error", res.error);
+        if (debug_) {
+            std::cerr << "[DEBUG] " << method << " " << path << " failed: " << res.error << "\n";
+        }
+        return ApiResponse(std::move(res));
+    }
+    span.set("bytes", static_cast<double>(res.body.size()));
+    
+    if (cached && res.status == 304) {
+        if (debug_) {
+            std::cerr << "[DEBUG] 304 Not Modified: " << path << " served from cache\n";
+        }
+        res.status = 200;
+        res.body = std::move(cached->body);
+        if (!cached->link.empty()) {
+            auto link = std::find_if(res.headers.begin(), res.headers.end(), [](const auto& h) {
+                return strcasecmp(h.first.c_str(), "Link") == 0;
+            });
+            if (link != res.headers.end()) {
+                link->second = std::move(cached->link);
+            } else {
+                res.headers.emplace_back("Link", std::move(cached->link));
+            }
+        }
+        span.set("cache", "hit");
+        return ApiResponse(std::move(res));
     }
     
-    // Convert headers to map (lowercase keys for case-insensitive lookup)
-    std::unordered_map<std::string, std::string> headers;
-    for (const auto& h : res->headers) {
-        headers[h.first] = h.second;
+    std::string_view etag = res.header("ETag");
+    if (useCache && res.status == 200 && !etag.empty()) {
+        CachedResponse entry;
+        entry.etag = etag;
+        entry.link = res.header("Link");
+        entry.body = res.body;
+        cache_->store(path, entry);
     }
     
-    return {res->status, res->body, headers};
+    return ApiResponse(std::move(res));
 }
@@ -2,42 +2,191 @@
 #define GITHUB_H
 
 #include <string>
+#include <string_view>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <atomic>
+#include <mutex>
 #include <optional>
 #include <vector>
 #include <utility>
 #include <unordered_map>
-#include <tuple>
+#include "constants.h"
+#include "identity_cache.h"
+#include "rate_limiter.h"
+#include "transport.h"
 
 struct RepoInfo {
     std::string name;
     std::string description;
-    bool isPrivate;
+    bool isPrivate = false;
     std::string htmlUrl;
     std::string sshUrl;
+    std::string updatedAt;
 };
 
+/**
+ * @brief OAuth scopes GitHub reported for the token with GET /user
+ */
+struct TokenScopes {
+    bool reported = false;              // Fine-grained tokens and app tokens send no X-OAuth-Scopes
+    std::vector<std::string> granted;   // X-OAuth-Scopes
+    std::vector<std::string> accepted;  // X-Accepted-OAuth-Scopes: what the request itself needed
+    
+    /**
+     * @brief True if the scope or one that includes it was granted
+     *        ("repo" includes "public_repo" and "repo:status")
+     */
+    bool has(const std::string& scope) const;
+};
+
+/**
+ * @brief Final answer to one API call, after retries and the ETag cache
+ * 
+ * Owns the transport's response and hands out its body and headers as views,
+ * valid for as long as the ApiResponse lives. Header lookup scans the
+ * response's own header list, ignoring case; nothing is copied per request.
+ */
+class ApiResponse {
+public:
+    ApiResponse() = default;
+    explicit ApiResponse(HttpResponse response) : response_(std::move(response)) {}
+    
+    int status() const { return response_.status; }
+    std::string_view body() const { return response_.body; }
+    std::string_view header(std::string_view name) const { return response_.header(name); }
+    
+    /**
+     * @brief Transport error message when status() is -1
+     */
+    const std::string& error() const { return response_.error; }
+    
+private:
+    HttpResponse response_;
+};
+
+/**
+ * @brief Per-call overrides for GitHubClient::request
+ */
+struct RequestOptions {
+    int timeout = 0;                            // Seconds for each attempt; 0 keeps the transport's
+    int maxRetries = constants::API_MAX_RETRIES;
+    bool cacheable = true;                      // GETs use the on-disk ETag cache
+};
+
+class Executor;
+class ResponseCache;
+class RepoIndex;
+struct RepoKey;
+class RepoList;
+
+/**
+ * @brief Called while a listing is fetched, each time pages are added to it
+ * @param repos The listing so far
+ * @param from Index of the first repository just added
+ */
+using RepoPageCallback = std::function<void(const RepoList& repos, size_t from)>;
+
+std::string parseLinkHeader(std::string_view linkHeader, const std::string& rel);
+int pageNumber(const std::string& path);
+std::vector<std::string> parseScopeList(const std::string& header);
+std::string withPageNumber(const std::string& path, int page);
+
 class GitHubClient {
 public:
-    GitHubClient(const std::string& token);
+    GitHubClient(const std::string& token, const std::string& apiBase = constants::API_BASE_URL);
+    ~GitHubClient();
     
-    bool authenticate();
+    const std::string& token() const { return token_; }
+    void setDebug(bool debug);
+    void setMaxParallelPages(size_t maxParallel);
+    void setCacheEnabled(bool enabled);
+    void setDataDir(const std::string& dir);
+    void setCompressionEnabled(bool enabled);
+    void setGraphQLEnabled(bool enabled) { graphqlEnabled_ = enabled; }
+    void setMutationInterval(std::chrono::milliseconds interval);
+    bool setTransport(TransportKind kind);
+    const char* transportName() const;
+    RateLimitStatus rateLimit() const;
+    
+    bool authenticate(bool refresh = false);
+    bool probeIdentity(int timeout, int& status);
+    bool warmUp();
     std::string getUsername();
+    std::optional<TokenScopes> tokenScopes();
     bool createRepository(const RepoInfo& repo);
+    bool updateRepository(const std::string& name,
+                          const std::optional<std::string>& description,
+                          std::optional<bool> isPrivate);
     bool repositoryExists(const std::string& name);
+    std::unordered_map<std::string, bool> repositoriesExist(const std::vector<std::string>& names);
     std::vector<RepoInfo> listRepositories();
+    RepoList listRepositoriesCompact(const RepoPageCallback& onPage = {});
+    std::vector<std::string> listOrganizations();
+    RepoList listOrganizationRepositories(const std::vector<std::string>& orgs,
+                                          const RepoPageCallback& onPage = {});
     bool deleteRepository(const std::string& name);
+    
+    RepoIndex& repoIndex();
+    bool syncIndex(bool forceFull = false);
+    
+    // Asynchronous variants: run on the client's executor, safe to call from many threads
+    std::future<bool> authenticateAsync(bool refresh = false);
+    std::future<bool> warmUpAsync();
+    std::future<std::string> getUsernameAsync();
+    std::future<bool> createRepositoryAsync(const RepoInfo& repo);
+    std::future<bool> updateRepositoryAsync(const std::string& name,
+                                            const std::optional<std::string>& description,
+                                            std::optional<bool> isPrivate);
+    std::future<bool> repositoryExistsAsync(const std::string& name);
+    std::future<std::unordered_map<std::string, bool>> repositoriesExistAsync(const std::vector<std::string>& names);
+    std::future<std::vector<RepoInfo>> listRepositoriesAsync();
+    std::future<bool> deleteRepositoryAsync(const std::string& name);
+    std::future<bool> syncIndexAsync(bool forceFull = false);
 
 private:
     std::string token_;
-    std::string apiBase_ = "https://api.github.com";
+    std::string apiBase_;
+    std::string dataDir_;
     std::optional<std::string> username_;
+    std::optional<CachedIdentity> identity_;
+    std::mutex usernameMutex_;
+    std::unique_ptr<Transport> transport_;
+    std::unique_ptr<ResponseCache> cache_;
+    std::unique_ptr<IdentityCache> identityCache_;
+    std::unique_ptr<RepoIndex> index_;
+    std::once_flag indexOnce_;
+    std::unique_ptr<RateLimiter> limiter_;
+    std::atomic<bool> debug_{false};
+    std::atomic<bool> compression_{true};
+    size_t maxParallelPages_ = constants::API_MAX_PARALLEL_PAGES;
+    std::atomic<bool> graphqlEnabled_{true};
+    
+    std::unordered_map<std::string, std::pair<bool, std::chrono::steady_clock::time_point>> existsCache_;
+    std::mutex existsMutex_;
+    std::mutex indexMutex_;
+    
+    // Declared last so queued async calls finish before the members they use go away
+    std::unique_ptr<Executor> executor_;
+    std::once_flag executorOnce_;
     
-    std::pair<int, std::string> request(const std::string& method, 
-                                         const std::string& path,
-                                         const std::string& body = "");
-    std::tuple<int, std::string, std::unordered_map<std::string, std::string>> requestWithHeaders(const std::string& method, 
-                                         const std::string& path,
-                                         const std::string& body = "");
+    bool identify(bool refresh = false);
+    bool storeIdentity(const ApiResponse& res);
+    bool fetchRepositories(RepoList& repos, const RepoPageCallback& onPage = {});
+    bool fetchRepositoriesGraphQL(RepoList& repos, bool& refused, const RepoPageCallback& onPage);
+    bool fetchRepositoriesRest(RepoList& repos, const std::string& firstPage,
+                               const RepoPageCallback& onPage = {});
+    bool lookupRepository(const std::string& owner, const std::string& name);
+    void rememberExists(const std::string& owner, const std::string& name, bool exists);
+    void updateIndex(const std::vector<RepoInfo>& changed, const std::vector<RepoKey>& removed);
+    Executor& executor();
+    TransportConfig transportConfig() const;
+    ApiResponse request(const std::string& method,
+                        const std::string& path,
+                        const std::string& body = "",
+                        const RequestOptions& options = {});
 };
 
 #endif
@@ -0,0 +1,101 @@
+/**
+ * @file httplib_transport.cpp
+ * @brief Default transport: blocking cpp-httplib clients from a keep-alive pool
+ */
+
+#include "transport.h"
+#include "connection_pool.h"
+#include <httplib.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief One blocking request per pooled connection
+ *
+ * Concurrency is bounded by the callers' threads; each in-flight request
+ * holds its own TCP/TLS connection. connectedAt and handshakeAt are never
+ * set: httplib does not expose those boundaries, so on a new connection
+ * they are part of the time to the response headers.
+ */
+class HttplibTransport : public Transport {
+public:
+    explicit HttplibTransport(const TransportConfig& config)
+        : timeout_(config.timeout),
+          pool_(config.baseUrl, config.maxConnections,
+                [headers = config.defaultHeaders, timeout = config.timeout](httplib::Client& cli) {
+                    cli.set_default_headers(httplib::Headers(headers.begin(), headers.end()));
+                    // httplib's timeouts apply per socket operation, not to the whole exchange
+                    setTimeouts(cli, timeout);
+                }) {}
+
+    const char* name() const override { return "httplib"; }
+    void setDebug(bool debug) override { pool_.setDebug(debug); }
+
+    HttpResponse send(const HttpRequest& request) override {
+        httplib::Headers headers(request.headers.begin(), request.headers.end());
+        HttpResponse response;
+        httplib::Result res;
+        {
+            auto conn = pool_.acquire();
+            auto& cli = conn.client();
+            response.reused = conn.reused();
+            // httplib has no whole-exchange timeout: a per-request one is split between
+            // connecting and waiting for the headers, and GET gives up on the body past it
+            if (request.timeout > 0) setTimeouts(cli, (request.timeout + 1) / 2);
+            response.sentAt = Clock::now();
+            auto deadline = response.sentAt + std::chrono::seconds(request.timeout);
+            auto inTime = [&request, deadline] {
+                return request.timeout <= 0 || Clock::now() < deadline;
+            };
+            if (request.method == "GET") {
+                // The response handler runs once the headers are in, which splits TTFB from transfer
+                std::string received;
+                res = cli.Get(request.path, headers,
+                    [&response, &inTime](const httplib::Response&) {
+                        response.headersAt = Clock::now();
+                        return inTime();
+                    },
+                    [&received, &inTime](const char* data, size_t length) {
+                        received.append(data, length);
+                        return inTime();
+                    });
+                if (res) res->body = std::move(received);
+            } else if (request.method == "POST") {
+                res = cli.Post(request.path, headers, request.body, request.contentType);
+            } else if (request.method == "PATCH") {
+                res = cli.Patch(request.path, headers, request.body, request.contentType);
+            } else {
+                res = cli.Delete(request.path, headers);
+            }
+            if (request.timeout > 0) setTimeouts(cli, timeout_);
+        }
+
+        if (!res) {
+            response.error = httplib::to_string(res.error());
+            return response;
+        }
+        response.status = res->status;
+        response.httpVersion = res->version.rfind("HTTP/", 0) == 0 ? res->version.substr(5) : res->version;
+        response.body = std::move(res->body);
+        response.headers.assign(res->headers.begin(), res->headers.end());
+        return response;
+    }
+
+private:
+    static void setTimeouts(httplib::Client& cli, int seconds) {
+        cli.set_connection_timeout(seconds);
+        cli.set_read_timeout(seconds);
+        cli.set_write_timeout(seconds);
+    }
+
+    int timeout_;
+    ConnectionPool pool_;
+};
+
+}  // namespace
+
+std::unique_ptr<Transport> makeHttplibTransport(const TransportConfig& config) {
+    return std::make_unique<HttplibTransport>(config);
+}
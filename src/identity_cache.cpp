@@ -0,0 +1,150 @@
+/**
+ * @file identity_cache.cpp
+ * @brief On-disk cache of the login, scopes and expiry behind a token
+ *
+ * Every command used to start with GET /user. With the same token run many
+ * times a day (CI), the answer hardly ever changes, so it is kept here for
+ * a day and dropped as soon as the API rejects the token.
+ */
+
+#include "identity_cache.h"
+#include "config.h"
+#include "constants.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#include <nlohmann/json.hpp>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+constexpr int IDENTITY_CACHE_VERSION = 2;
+}
+
+IdentityCache::IdentityCache(const std::string& dir, const std::string& token)
+    : dir_(dir), fingerprint_(sha256Hex(token)) {
+    path_ = dir_ + "/" + constants::IDENTITY_FILE_PREFIX + fingerprint_.substr(0, 16) + ".json";
+}
+
+/**
+ * @brief Loads the cached identity
+ * @param now Current time, seconds since the epoch
+ * @return Identity, or nullopt if missing, for another token, older than
+ *         the TTL or past the token's expiry
+ */
+std::optional<CachedIdentity> IdentityCache::load(std::time_t now) const {
+    std::ifstream file(path_);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    
+    CachedIdentity identity;
+    try {
+        json data = json::parse(file);
+        if (data.value("version", 0) != IDENTITY_CACHE_VERSION ||
+            data.value("fingerprint", "") != fingerprint_) {
+            return std::nullopt;
+        }
+        identity.login = data.value("login", "");
+        identity.scopes = data.value("scopes", "");
+        identity.acceptedScopes = data.value("accepted_scopes", "");
+        identity.scopesReported = data.value("scopes_reported", false);
+        identity.expiresAt = data.value("expires_at", "");
+        identity.fetchedAt = data.value("fetched_at", static_cast<std::time_t>(0));
+    } catch (...) {
+        return std::nullopt;
+    }
+    
+    if (identity.login.empty() || now < identity.fetchedAt ||
+        now - identity.fetchedAt >= constants::IDENTITY_CACHE_TTL) {
+        return std::nullopt;
+    }
+    if (!identity.expiresAt.empty()) {
+        auto expires = parseTokenExpiration(identity.expiresAt);
+        if (!expires || now >= *expires) {
+            return std::nullopt;
+        }
+    }
+    return identity;
+}
+
+/**
+ * @brief Writes the identity, replacing any previous entry atomically
+ * @return true if the entry was written
+ */
+bool IdentityCache::store(const CachedIdentity& identity) const {
+    if (identity.login.empty()) {
+        return false;
+    }
+    
+    json data = {
+        {"version", IDENTITY_CACHE_VERSION},
+        {"fingerprint", fingerprint_},
+        {"login", identity.login},
+        {"scopes", identity.scopes},
+        {"accepted_scopes", identity.acceptedScopes},
+        {"scopes_reported", identity.scopesReported},
+        {"expires_at", identity.expiresAt},
+        {"fetched_at", identity.fetchedAt}
+    };
+    
+    std::error_code ec;
+    fs::create_directories(dir_, ec);
+    
+    std::ostringstream tmpName;
+    tmpName << path_ << ".tmp." << getpid() << "." << std::this_thread::get_id();
+    {
+        std::ofstream file(tmpName.str(), std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file << data.dump(2) << "\n";
+        if (!file) {
+            fs::remove(tmpName.str(), ec);
+            return false;
+        }
+    }
+    fs::rename(tmpName.str(), path_, ec);
+    if (ec) {
+        fs::remove(tmpName.str(), ec);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Forgets the identity so the next authentication asks the API
+ */
+void IdentityCache::invalidate() const {
+    std::error_code ec;
+    fs::remove(path_, ec);
+}
+
+std::optional<std::time_t> parseTokenExpiration(const std::string& value) {
+    std::tm tm{};
+    char zone[16] = {0};
+    int fields = std::sscanf(value.c_str(), "%d-%d-%d %d:%d:%d %15s",
+                             &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
+                             &tm.tm_hour, &tm.tm_min, &tm.tm_sec, zone);
+    if (fields < 6) {
+        return std::nullopt;
+    }
+    tm.tm_year -= 1900;
+    tm.tm_mon -= 1;
+    std::time_t seconds = timegm(&tm);
+    
+    // "UTC" or a numeric offset such as "+0200"
+    std::string offset = zone;
+    if (offset.size() == 5 && (offset[0] == '+' || offset[0] == '-') &&
+        offset.find_first_not_of("0123456789", 1) == std::string::npos) {
+        int hours = std::stoi(offset.substr(1, 2));
+        int minutes = std::stoi(offset.substr(3, 2));
+        int delta = (hours * 60 + minutes) * 60;
+        seconds += offset[0] == '+' ? -delta : delta;
+    }
+    return seconds;
+}
@@ -0,0 +1,51 @@
+#ifndef IDENTITY_CACHE_H
+#define IDENTITY_CACHE_H
+
+#include <ctime>
+#include <optional>
+#include <string>
+
+/**
+ * @brief What GET /user told us about a token
+ */
+struct CachedIdentity {
+    std::string login;
+    std::string scopes;      // X-OAuth-Scopes as sent; empty for fine-grained tokens
+    std::string expiresAt;   // GitHub-Authentication-Token-Expiration, empty if the token never expires
+    std::time_t fetchedAt = 0;
+    std::string acceptedScopes;   // X-Accepted-OAuth-Scopes of GET /user
+    bool scopesReported = false;  // X-OAuth-Scopes was present, even if empty
+};
+
+/**
+ * @brief On-disk cache of the authenticated identity, one file per token
+ *
+ * Lets repeated runs with the same token skip the GET /user round trip.
+ * Entries live under ~/.gh-repo-create and are keyed and checked by the
+ * token's SHA-256 fingerprint; the token itself is never written. An entry
+ * is used for constants::IDENTITY_CACHE_TTL seconds and never past the
+ * token's own expiry.
+ */
+class IdentityCache {
+public:
+    IdentityCache(const std::string& dir, const std::string& token);
+
+    std::optional<CachedIdentity> load(std::time_t now = std::time(nullptr)) const;
+    bool store(const CachedIdentity& identity) const;
+    void invalidate() const;
+
+    const std::string& path() const { return path_; }
+
+private:
+    std::string dir_;
+    std::string path_;
+    std::string fingerprint_;
+};
+
+/**
+ * @brief Parses GitHub's token expiration header ("2026-11-01 12:00:00 UTC")
+ * @return Seconds since the epoch, or nullopt if the value is not a timestamp
+ */
+std::optional<std::time_t> parseTokenExpiration(const std::string& value);
+
+#endif
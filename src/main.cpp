@@ -2,9 +2,22 @@
 #include "github.h"
 #include "config.h"
 #include "git_utils.h"
+#include "reconcile.h"
+#include "system_check.h"
+#include "repo_index.h"
+#include "repo_list.h"
+#include "constants.h"
+#include "metrics.h"
+#include "output.h"
+#include "trace.h"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <cstring>
+#include <vector>
 
 std::string safeToken(const std::string& token) {
     if (token.length() <= 5) {
@@ -17,6 +30,7 @@ void printUsage(const char* progName) {
     std::cout << R"(gh-repo-create - Create GitHub repositories from the command line
 
 Usage: )" << progName << R"( [options]
+       )" << progName << R"( apply <manifest.json> [--dry-run] [--jobs <n>]
 
 Options:
   -p, --path <dir>       Path to local git repository
@@ -25,21 +39,58 @@ Options:
       --public           Make repository public
       --private          Make repository private
   -l, --list             List all your GitHub repositories
+      --org <a,b,...>    List the repositories of these organizations
+      --all-orgs         List the repositories of every organization you belong to
+      --format <f>       Output of list, create, delete and check: text (default),
+                         json, ndjson or tsv
   -D, --delete <name>    Delete a repository by name
       --ssh-only         Skip GitHub API, just push via SSH
+      --no-cache         Do not use the on-disk API response or identity cache
+      --no-compress      Request uncompressed API responses
+      --transport <t>    HTTP backend: httplib (default) or curl
+      --dry-run          With apply: show the planned changes, call nothing
+      --jobs <n>         With apply: maximum concurrent API calls
+      --trace <file>     Write request and subprocess timings as Chrome trace JSON
+      --metrics <file>   Write API and subprocess counters as OpenMetrics text
+      --debug            Print API request details to stderr
   -h, --help             Show this help message
 
 Examples:
   )" << progName << R"( --path ./my-project --name my-repo --public
   )" << progName << R"( -p . -n new-repo -d "My project" --private
   )" << progName << R"( --list
+  )" << progName << R"( --list --org my-org,other-org
+  )" << progName << R"( --list --format ndjson | jq -r .ssh_url
   )" << progName << R"( --delete my-old-repo
   )" << progName << R"( --ssh-only -p .
+  )" << progName << R"( apply repos.json --dry-run
+  )" << progName << R"( --trace create.json -p . -n my-repo
 
-Or run without arguments to enter interactive REPL mode.
+Or run without arguments (or with only --debug/--trace/--metrics) to enter interactive REPL mode.
 )";
 }
 
+/**
+ * @brief Writes the requested trace and metrics files when main returns
+ */
+struct RunReports {
+    std::string tracePath;
+    std::string metricsPath;
+    
+    ~RunReports() {
+        if (!tracePath.empty()) {
+            if (Trace::instance().write(tracePath)) {
+                std::cerr << "Trace written to " << tracePath << " (" << Trace::instance().size() << " spans)\n";
+            } else {
+                std::cerr << "Error: Could not write trace to " << tracePath << "\n";
+            }
+        }
+        if (!metricsPath.empty() && !Metrics::instance().write(metricsPath)) {
+            std::cerr << "Error: Could not write metrics to " << metricsPath << "\n";
+        }
+    }
+};
+
 int main(int argc, char* argv[]) {
     if (argc == 1) {
         REPL repl;
@@ -47,12 +98,21 @@ int main(int argc, char* argv[]) {
         return 0;
     }
     
-    std::string path, name, description, deleteName;
+    std::string path, name, description, deleteName, manifestPath, tracePath, metricsPath;
     bool isPrivate = false;
     bool listRepos = false;
+    std::vector<std::string> orgs;
+    bool allOrgs = false;
     bool sshOnly = false;
     bool runCheck = false;
     bool debugMode = false;
+    bool useCache = true;
+    bool useCompression = true;
+    bool dryRun = false;
+    size_t jobs = constants::API_MAX_CONNECTIONS;
+    TransportKind transport = TransportKind::Httplib;
+    OutputFormat format = OutputFormat::Text;
+    int replArgs = 0;  // Arguments that still allow the REPL: --debug, --trace/--metrics <file>
     
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
@@ -60,6 +120,13 @@ int main(int argc, char* argv[]) {
             return 0;
         } else if (strcmp(argv[i], "--debug") == 0) {
             debugMode = true;
+            replArgs++;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+            replArgs += 2;
+        } else if (strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) {
+            metricsPath = argv[++i];
+            replArgs += 2;
         } else if (strcmp(argv[i], "--check") == 0) {
             runCheck = true;
         } else if ((strcmp(argv[i], "-p") == 0 || strcmp(argv[i], "--path") == 0) && i + 1 < argc) {
@@ -74,13 +141,69 @@ int main(int argc, char* argv[]) {
             isPrivate = true;
         } else if (strcmp(argv[i], "-l") == 0 || strcmp(argv[i], "--list") == 0) {
             listRepos = true;
+        } else if (strcmp(argv[i], "--org") == 0 && i + 1 < argc) {
+            std::stringstream list(argv[++i]);
+            std::string org;
+            while (std::getline(list, org, ',')) {
+                if (!org.empty()) orgs.push_back(org);
+            }
+            listRepos = true;
+        } else if (strcmp(argv[i], "--all-orgs") == 0) {
+            allOrgs = true;
+            listRepos = true;
         } else if ((strcmp(argv[i], "-D") == 0 || strcmp(argv[i], "--delete") == 0) && i + 1 < argc) {
             deleteName = argv[++i];
         } else if (strcmp(argv[i], "--ssh-only") == 0) {
             sshOnly = true;
+        } else if (strcmp(argv[i], "--no-cache") == 0) {
+            useCache = false;
+        } else if (strcmp(argv[i], "--no-compress") == 0) {
+            useCompression = false;
+        } else if (strcmp(argv[i], "--transport") == 0 && i + 1 < argc) {
+            auto kind = parseTransportKind(argv[++i]);
+            if (!kind) {
+                std::cerr << "Error: Unknown transport '" << argv[i] << "' (expected httplib or curl)\n";
+                return 1;
+            }
+            transport = *kind;
+            auto built = availableTransports();
+            if (std::find(built.begin(), built.end(), transport) == built.end()) {
+                std::cerr << "Error: This build does not include the " << argv[i] << " transport\n";
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            auto parsed = parseOutputFormat(argv[++i]);
+            if (!parsed) {
+                std::cerr << "Error: Unknown format '" << argv[i] << "' (expected text, json, ndjson or tsv)\n";
+                return 1;
+            }
+            format = *parsed;
+        } else if (strcmp(argv[i], "apply") == 0 && i + 1 < argc) {
+            manifestPath = argv[++i];
+        } else if (strcmp(argv[i], "--dry-run") == 0) {
+            dryRun = true;
+        } else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            int n = std::atoi(argv[++i]);
+            jobs = n > 0 ? static_cast<size_t>(n) : 1;
         }
     }
     
+    RunReports reports{tracePath, metricsPath};
+    if (!tracePath.empty()) {
+        Trace::instance().enable();
+    }
+    
+    if (replArgs == argc - 1) {
+        REPL repl;
+        repl.setDebug(debugMode);
+        repl.run();
+        return 0;
+    }
+    
+    const char* command = runCheck ? "check" : sshOnly ? "ssh-only" : !manifestPath.empty() ? "apply" :
+                          listRepos ? "list" : !deleteName.empty() ? "delete" : "create";
+    Trace::Span commandSpan(command, "command");
+    
     ConfigManager config;
     
     if (debugMode) {
@@ -92,89 +215,36 @@ int main(int argc, char* argv[]) {
     
     if (path.empty()) path = ".";
     
+    // With --format, stdout carries only records; progress and errors go to stderr.
+    // apply and --ssh-only keep their text output
+    std::unique_ptr<OutputWriter> writer;
+    if (format != OutputFormat::Text && manifestPath.empty() && !sshOnly) {
+        writer = std::make_unique<OutputWriter>(format, std::cout);
+    }
+    std::ostream& progress = writer ? std::cerr : std::cout;
+    
     if (runCheck) {
         const std::string RESET = "\033[0m";
         const std::string BOLD = "\033[1m";
         const std::string GREEN = "\033[32m";
         const std::string RED = "\033[31m";
-        const std::string YELLOW = "\033[33m";
-        const std::string GRAY = "\033[90m";
         
-        std::cout << "\n" << BOLD << "System Check" << RESET << "\n";
-        std::cout << std::string(40, '-') << "\n\n";
-        
-        bool allPassed = true;
-        
-        std::cout << BOLD << "1. GitHub API Access\n" << RESET;
-        if (!token.has_value()) {
-            std::cout << RED << "   [FAIL] " << RESET << "No GitHub token found\n";
-            std::cout << GRAY << "   -> Set GH_TOKEN environment variable or add token to ~/.gh-repo-create.json\n" << RESET;
-            std::cout << GRAY << "   -> See: https://github.com/settings/tokens\n" << RESET;
-            allPassed = false;
-        } else {
-            GitHubClient client(token.value());
-            if (client.authenticate()) {
-                std::cout << GREEN << "   [PASS] " << RESET << "Authenticated as: " << client.getUsername() << "\n";
-            } else {
-                std::cout << RED << "   [FAIL] " << RESET << "Authentication failed - invalid token\n";
-                std::cout << GRAY << "   -> Your token may have expired or been revoked\n" << RESET;
-                std::cout << GRAY << "   -> Generate a new token at: https://github.com/settings/tokens\n" << RESET;
-                allPassed = false;
-            }
+        std::unique_ptr<GitHubClient> client;
+        if (token.has_value()) {
+            client = std::make_unique<GitHubClient>(token.value());
+            client->setTransport(transport);
+            client->setDebug(debugMode);
+            client->setCacheEnabled(useCache);
+            client->setCompressionEnabled(useCompression);
         }
-        std::cout << "\n";
-        
-        std::cout << BOLD << "2. GitHub SSH Access\n" << RESET;
-        FILE* pipe = popen("ssh -T git@github.com 2>&1", "r");
-        if (pipe) {
-            char buffer[256] = {0};
-            std::string output;
-            while (fgets(buffer, sizeof(buffer), pipe)) {
-                output += buffer;
-            }
-            pclose(pipe);
-            
-            if (output.find("successfully authenticated") != std::string::npos || 
-                output.find("You've successfully authenticated") != std::string::npos) {
-                std::cout << GREEN << "   [PASS] " << RESET << "SSH access to GitHub working\n";
-            } else {
-                std::cout << RED << "   [FAIL] " << RESET << "SSH access not configured\n";
-                std::cout << GRAY << "   -> Add SSH key to GitHub: Settings > SSH and GPG keys\n" << RESET;
-                std::cout << GRAY << "   -> Run: ssh-add ~/.ssh/id_ed25519\n" << RESET;
-                allPassed = false;
-            }
-        } else {
-            std::cout << RED << "   [FAIL] " << RESET << "Could not test SSH\n";
-            allPassed = false;
+        const char* hint = "Set GH_TOKEN environment variable or add token to ~/.gh-repo-create.json";
+        if (writer) {
+            return runSystemCheck(client.get(), path, hint, writer.get()) ? 0 : 1;
         }
-        std::cout << "\n";
         
-        std::cout << BOLD << "3. Local Git Repository\n" << RESET;
-        if (GitUtils::isGitRepo(path)) {
-            std::cout << GREEN << "   [PASS] " << RESET << path << " is a git repository\n";
-            
-            if (GitUtils::hasRemote(path, "origin")) {
-                auto remoteUrl = GitUtils::getRemoteUrl(path, "origin");
-                if (remoteUrl.has_value()) {
-                    std::cout << GREEN << "   [PASS] " << RESET << "Origin remote: " << remoteUrl.value() << "\n";
-                }
-            } else {
-                std::cout << YELLOW << "   [WARN] " << RESET << "No 'origin' remote configured\n";
-            }
-        } else {
-            std::cout << YELLOW << "   [SKIP] " << RESET << path << " is not a git repository\n";
-        }
-        std::cout << "\n";
-        
-        if (token.has_value()) {
-            std::cout << BOLD << "4. Token Permissions\n" << RESET;
-            GitHubClient client(token.value());
-            client.authenticate();
-            auto repos = client.listRepositories();
-            std::cout << GREEN << "   [PASS] " << RESET << "List repositories: OK (" << repos.size() << " repos)\n";
-            std::cout << GRAY << "   Token has 'repo' scope\n" << RESET;
-            std::cout << "\n";
-        }
+        std::cout << "\n" << BOLD << "System Check" << RESET << "\n";
+        std::cout << std::string(40, '-') << "\n\n";
+        bool allPassed = runSystemCheck(client.get(), path, hint);
         
         std::cout << std::string(40, '-') << "\n";
         if (allPassed) {
@@ -218,38 +288,136 @@ int main(int argc, char* argv[]) {
     }
     
     GitHubClient client(token.value());
+    client.setTransport(transport);
+    client.setDebug(debugMode);
+    client.setCacheEnabled(useCache);
+    client.setCompressionEnabled(useCompression);
     if (!client.authenticate()) {
         std::cerr << "Error: Authentication failed\n";
         return 1;
     }
     
+    if (!manifestPath.empty()) {
+        std::vector<ManifestEntry> manifest;
+        std::string error;
+        if (!loadManifest(manifestPath, manifest, error)) {
+            std::cerr << "Error: " << error << "\n";
+            return 1;
+        }
+        
+        // Planning against a stale listing could recreate or delete the
+        // wrong thing, so always start from a complete, fresh one
+        if (!client.syncIndex(true)) {
+            std::cerr << "Error: Could not list current repositories\n";
+            return 1;
+        }
+        auto actions = planReconcile(manifest, ownRepositories(client.repoIndex(), client.getUsername()));
+        
+        if (actions.empty()) {
+            std::cout << "Nothing to do: " << manifest.size() << " repository(ies) already match the manifest.\n";
+            return 0;
+        }
+        
+        if (dryRun) {
+            std::cout << "Planned changes:\n";
+            for (const auto& action : actions) {
+                std::cout << "  " << describeAction(action) << "\n";
+            }
+            std::cout << "Dry run: " << actions.size() << " API call(s) would be made.\n";
+            return 0;
+        }
+        
+        std::cout << "Applying " << actions.size() << " change(s)...\n";
+        auto results = applyReconcile(client, actions, jobs, [](const ReconcileResult& result) {
+            std::cout << (result.ok ? "  [OK]   " : "  [FAIL] ") << describeAction(result.action) << "\n";
+        });
+        
+        size_t failed = std::count_if(results.begin(), results.end(),
+                                      [](const ReconcileResult& r) { return !r.ok; });
+        std::cout << "Done: " << results.size() - failed << " succeeded, " << failed << " failed.\n";
+        return failed == 0 ? 0 : 1;
+    }
+    
     if (listRepos) {
-        auto repos = client.listRepositories();
+        bool byOrg = allOrgs || !orgs.empty();
+        if (allOrgs) {
+            orgs = client.listOrganizations();
+            if (orgs.empty()) {
+                progress << "You do not belong to any organization.\n";
+                return 0;
+            }
+        }
+        
+        if (writer) {
+            // ndjson goes out page by page, so consumers start before pagination ends
+            RepoPageCallback onPage;
+            if (format == OutputFormat::Ndjson) {
+                onPage = [&writer](const RepoList& page, size_t from) {
+                    for (size_t i = from; i < page.size(); i++) {
+                        writer->repo(page, i);
+                    }
+                    writer->flush();
+                };
+            }
+            RepoList repos = byOrg ? client.listOrganizationRepositories(orgs, onPage)
+                                   : client.listRepositoriesCompact(onPage);
+            if (!onPage) {
+                for (size_t i = 0; i < repos.size(); i++) {
+                    writer->repo(repos, i);
+                }
+            }
+            return 0;
+        }
+        
+        RepoList repos = byOrg ? client.listOrganizationRepositories(orgs) : client.listRepositoriesCompact();
         if (repos.empty()) {
             std::cout << "No repositories found.\n";
         } else {
-            std::cout << "Your Repositories:\n";
+            std::cout << (byOrg ? "Organization Repositories:\n" : "Your Repositories:\n");
             std::cout << std::string(60, '-') << "\n";
-            for (const auto& repo : repos) {
-                std::string visibility = repo.isPrivate ? "private" : "public";
-                std::cout << repo.name << " [" << visibility << "]\n";
-                if (!repo.description.empty()) {
-                    std::cout << "  " << repo.description << "\n";
+            for (size_t i = 0; i < repos.size(); i++) {
+                std::string visibility = repos.isPrivate(i) ? "private" : "public";
+                if (byOrg && !repos.owner(i).empty()) {
+                    std::cout << repos.owner(i) << "/";
                 }
-                std::cout << "  " << repo.htmlUrl << "\n\n";
+                std::cout << repos.name(i) << " [" << visibility << "]\n";
+                if (!repos.description(i).empty()) {
+                    std::cout << "  " << repos.description(i) << "\n";
+                }
+                std::cout << "  " << repos.htmlUrl(i) << "\n\n";
+            }
+            std::cout << "Total: " << repos.size() << " repository(ies)";
+            if (byOrg) {
+                std::cout << " in " << orgs.size() << " organization(s)";
             }
-            std::cout << "Total: " << repos.size() << " repository(ies)\n";
+            std::cout << "\n";
         }
         return 0;
     }
     
+    // One record per create or delete in --format modes, whatever the outcome
+    auto report = [&writer](const char* action, const std::string& repoName, bool ok,
+                            const std::string& sshUrl, bool pushed, const std::string& error) {
+        if (!writer) return;
+        writer->beginRecord();
+        writer->field("action", action);
+        writer->field("name", repoName);
+        writer->field("ok", ok);
+        writer->field("ssh_url", sshUrl);
+        writer->field("pushed", pushed);
+        writer->field("error", error);
+        writer->endRecord();
+    };
+    
     if (!deleteName.empty()) {
-        std::cout << "Deleting repository '" << deleteName << "'...\n";
+        progress << "Deleting repository '" << deleteName << "'...\n";
         if (client.deleteRepository(deleteName)) {
-            std::cout << "Repository deleted successfully!\n";
+            progress << "Repository deleted successfully!\n";
+            report("delete", deleteName, true, "", false, "");
             return 0;
         } else {
             std::cerr << "Error: Failed to delete repository\n";
+            report("delete", deleteName, false, "", false, "Failed to delete repository");
             return 1;
         }
     }
@@ -267,6 +435,7 @@ int main(int argc, char* argv[]) {
     
     if (!GitUtils::isGitRepo(path)) {
         std::cerr << "Error: " << path << " is not a git repository\n";
+        report("create", name, false, "", false, path + " is not a git repository");
         return 1;
     }
     
@@ -274,6 +443,7 @@ int main(int argc, char* argv[]) {
     
     if (client.repositoryExists(name)) {
         std::cerr << "Error: Repository '" << name << "' already exists on your GitHub account.\n";
+        report("create", name, false, "", false, "Repository already exists");
         return 1;
     }
     
@@ -282,10 +452,10 @@ int main(int argc, char* argv[]) {
     repo.description = description;
     repo.isPrivate = isPrivate;
     
-    std::cout << "Creating repository '" << name << "'...\n";
+    progress << "Creating repository '" << name << "'...\n";
     
     if (client.createRepository(repo)) {
-        std::cout << "Repository created successfully!\n";
+        progress << "Repository created successfully!\n";
         
         std::string sshUrl = "git@github.com:" + client.getUsername() + "/" + name + ".git";
         
@@ -298,14 +468,17 @@ int main(int argc, char* argv[]) {
         auto branch = GitUtils::getCurrentBranch(path);
         if (branch.has_value()) {
             if (GitUtils::push(path, "origin", branch.value())) {
-                std::cout << "Pushed successfully!\n";
+                progress << "Pushed successfully!\n";
             } else {
                 std::cerr << "Push failed\n";
+                report("create", name, true, sshUrl, false, "Push failed");
                 return 1;
             }
         }
+        report("create", name, true, sshUrl, branch.has_value(), "");
     } else {
         std::cerr << "Failed to create repository\n";
+        report("create", name, false, "", false, "Failed to create repository");
         return 1;
     }
     
@@ -0,0 +1,333 @@
+/**
+ * @file metrics.cpp
+ * @brief Client counters, latency histograms and their OpenMetrics export
+ */
+
+#include "metrics.h"
+#include "constants.h"
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+
+namespace {
+
+constexpr size_t BUCKET_COUNT = sizeof(constants::METRICS_LATENCY_BUCKETS) / sizeof(double);
+
+/**
+ * @brief Escapes a label value: backslash, double quote and newline
+ */
+std::string escape(const std::string& value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            out += '\\';
+            out += c;
+        } else if (c == '\n') {
+            out += "\\n";
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+std::string name(const char* metric) {
+    return std::string(constants::METRICS_PREFIX) + "_" + metric;
+}
+
+void family(std::ostream& out, const std::string& metric, const char* type, const char* help,
+            const char* unit = nullptr) {
+    out << "# TYPE " << metric << " " << type << "\n";
+    if (unit) out << "# UNIT " << metric << " " << unit << "\n";
+    out << "# HELP " << metric << " " << help << "\n";
+}
+
+/**
+ * @brief Writes the _bucket/_count/_sum samples of one histogram
+ */
+void histogram(std::ostream& out, const std::string& metric, const std::string& labels,
+               const Metrics::Histogram& h) {
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < h.buckets.size(); i++) {
+        cumulative += h.buckets[i];
+        out << metric << "_bucket{" << labels << ",le=\"";
+        if (i < BUCKET_COUNT) {
+            out << constants::METRICS_LATENCY_BUCKETS[i];
+        } else {
+            out << "+Inf";
+        }
+        out << "\"} " << cumulative << "\n";
+    }
+    out << metric << "_count{" << labels << "} " << h.count << "\n";
+    out << metric << "_sum{" << labels << "} " << h.sum << "\n";
+}
+
+std::string formatBytes(uint64_t bytes) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    if (bytes >= 1024 * 1024) {
+        out << bytes / (1024.0 * 1024.0) << " MiB";
+    } else if (bytes >= 1024) {
+        out << bytes / 1024.0 << " KiB";
+    } else {
+        out << std::setprecision(0) << static_cast<double>(bytes) << " B";
+    }
+    return out.str();
+}
+
+}  // namespace
+
+// ============================================================================
+// Histogram
+// ============================================================================
+
+Metrics::Histogram::Histogram() : buckets(BUCKET_COUNT + 1, 0) {}
+
+void Metrics::Histogram::observe(double seconds) {
+    size_t i = 0;
+    while (i < BUCKET_COUNT && seconds > constants::METRICS_LATENCY_BUCKETS[i]) {
+        i++;
+    }
+    buckets[i]++;
+    sum += seconds;
+    count++;
+}
+
+/**
+ * @brief Approximates a quantile by the upper bound of its bucket
+ * @return Seconds, or 0 for an empty histogram; the last finite bound for +Inf
+ */
+double Metrics::Histogram::quantile(double q) const {
+    if (count == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += buckets[i];
+        if (seen >= rank) return constants::METRICS_LATENCY_BUCKETS[i];
+    }
+    return constants::METRICS_LATENCY_BUCKETS[BUCKET_COUNT - 1];
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+Metrics& Metrics::instance() {
+    static Metrics metrics;
+    return metrics;
+}
+
+std::string Metrics::endpoint(const std::string& path) {
+    std::string route = path.substr(0, path.find('?'));
+
+    // /repos/{owner}/{repo}/..., /users/{user}/..., /orgs/{org}/...
+    std::vector<std::string> segments;
+    std::stringstream stream(route);
+    std::string segment;
+    while (std::getline(stream, segment, '/')) {
+        if (!segment.empty()) segments.push_back(segment);
+    }
+    if (segments.size() >= 2) {
+        if (segments[0] == "repos") {
+            segments[1] = "{owner}";
+            if (segments.size() >= 3) segments[2] = "{repo}";
+        } else if (segments[0] == "users") {
+            segments[1] = "{user}";
+        } else if (segments[0] == "orgs") {
+            segments[1] = "{org}";
+        }
+    }
+
+    std::string out;
+    for (const auto& s : segments) {
+        out += "/" + s;
+    }
+    return out.empty() ? "/" : out;
+}
+
+void Metrics::recordRequest(const std::string& method, const std::string& path, int status, double seconds,
+                            size_t bytesIn, size_t bytesOut, bool retry) {
+    std::string route = endpoint(path);
+    std::lock_guard<std::mutex> lock(mutex_);
+    Endpoint& e = endpoints_[route];
+    e.byMethodStatus[{method, status}]++;
+    e.latency.observe(seconds);
+    e.bytesIn += bytesIn;
+    e.bytesOut += bytesOut;
+    if (retry) e.retries++;
+}
+
+void Metrics::recordCacheLookup(bool hit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    (hit ? cacheHits_ : cacheMisses_)++;
+}
+
+void Metrics::recordSubprocess(const std::string& command, double seconds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    subprocesses_[command].duration.observe(seconds);
+}
+
+uint64_t Metrics::requests() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t total = 0;
+    for (const auto& [route, e] : endpoints_) total += e.latency.count;
+    return total;
+}
+
+uint64_t Metrics::retries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t total = 0;
+    for (const auto& [route, e] : endpoints_) total += e.retries;
+    return total;
+}
+
+uint64_t Metrics::cacheHits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cacheHits_;
+}
+
+uint64_t Metrics::cacheMisses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cacheMisses_;
+}
+
+uint64_t Metrics::subprocesses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t total = 0;
+    for (const auto& [command, p] : subprocesses_) total += p.duration.count;
+    return total;
+}
+
+// ============================================================================
+// Export
+// ============================================================================
+
+/**
+ * @brief Renders every metric in the OpenMetrics text format
+ *
+ * Status -1 stands for requests that failed before a response (network
+ * errors). The output ends with "# EOF"; Prometheus-format parsers such as
+ * node_exporter's textfile collector read it as a comment.
+ */
+std::string Metrics::toOpenMetrics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream out;
+    out << std::setprecision(9);
+
+    std::string requestsMetric = name("api_requests");
+    family(out, requestsMetric, "counter", "GitHub API requests by endpoint, method and status.");
+    for (const auto& [route, e] : endpoints_) {
+        for (const auto& [key, count] : e.byMethodStatus) {
+            out << requestsMetric << "_total{endpoint=\"" << escape(route) << "\",method=\"" << key.first
+                << "\",status=\"" << key.second << "\"} " << count << "\n";
+        }
+    }
+
+    std::string latency = name("api_request_duration_seconds");
+    family(out, latency, "histogram", "GitHub API request latency from send to end of response.", "seconds");
+    for (const auto& [route, e] : endpoints_) {
+        histogram(out, latency, "endpoint=\"" + escape(route) + "\"", e.latency);
+    }
+
+    std::string retriesMetric = name("api_retries");
+    family(out, retriesMetric, "counter", "GitHub API requests that were retries of an earlier attempt.");
+    for (const auto& [route, e] : endpoints_) {
+        out << retriesMetric << "_total{endpoint=\"" << escape(route) << "\"} " << e.retries << "\n";
+    }
+
+    std::string bytes = name("api_bytes");
+    family(out, bytes, "counter", "Bytes of API request and (decoded) response bodies.", "bytes");
+    for (const auto& [route, e] : endpoints_) {
+        out << bytes << "_total{endpoint=\"" << escape(route) << "\",direction=\"in\"} " << e.bytesIn << "\n";
+        out << bytes << "_total{endpoint=\"" << escape(route) << "\",direction=\"out\"} " << e.bytesOut << "\n";
+    }
+
+    std::string cache = name("api_cache_lookups");
+    family(out, cache, "counter", "Response cache lookups for GET requests by result.");
+    out << cache << "_total{result=\"hit\"} " << cacheHits_ << "\n";
+    out << cache << "_total{result=\"miss\"} " << cacheMisses_ << "\n";
+
+    std::string spawns = name("subprocesses");
+    family(out, spawns, "counter", "git and ssh subprocesses started, by command.");
+    for (const auto& [command, p] : subprocesses_) {
+        out << spawns << "_total{command=\"" << escape(command) << "\"} " << p.duration.count << "\n";
+    }
+
+    std::string duration = name("subprocess_duration_seconds");
+    family(out, duration, "histogram", "git and ssh subprocess run time, by command.", "seconds");
+    for (const auto& [command, p] : subprocesses_) {
+        histogram(out, duration, "command=\"" + escape(command) + "\"", p.duration);
+    }
+
+    std::string written = name("metrics_written_timestamp_seconds");
+    family(out, written, "gauge", "Unix time these metrics were written.", "seconds");
+    out << written << " " << std::time(nullptr) << "\n";
+
+    out << "# EOF\n";
+    return out.str();
+}
+
+/**
+ * @brief Human-readable report for the REPL `stats` command
+ */
+std::string Metrics::summary() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream out;
+
+    uint64_t total = 0, retried = 0, in = 0, sent = 0;
+    for (const auto& [route, e] : endpoints_) {
+        total += e.latency.count;
+        retried += e.retries;
+        in += e.bytesIn;
+        sent += e.bytesOut;
+    }
+    out << "API requests: " << total << " (" << retried << " retries), "
+        << formatBytes(in) << " in, " << formatBytes(sent) << " out\n";
+    out << "Cache: " << cacheHits_ << " hits, " << cacheMisses_ << " misses\n";
+
+    if (!endpoints_.empty()) {
+        out << "\n  " << std::left << std::setw(32) << "endpoint" << std::right << std::setw(9) << "requests"
+            << std::setw(10) << "p50 ms" << std::setw(10) << "p99 ms" << "  statuses\n";
+        for (const auto& [route, e] : endpoints_) {
+            out << "  " << std::left << std::setw(32) << route << std::right << std::setw(9) << e.latency.count
+                << std::setw(10) << "<=" + std::to_string(static_cast<int>(e.latency.quantile(0.5) * 1000))
+                << std::setw(10) << "<=" + std::to_string(static_cast<int>(e.latency.quantile(0.99) * 1000)) << " ";
+            for (const auto& [key, count] : e.byMethodStatus) {
+                out << " " << key.first << " " << key.second << " x" << count;
+            }
+            out << "\n";
+        }
+    }
+
+    if (!subprocesses_.empty()) {
+        out << "\nSubprocesses:\n";
+        for (const auto& [command, p] : subprocesses_) {
+            out << "  " << std::left << std::setw(32) << command << std::right << std::setw(9) << p.duration.count
+                << " runs, " << std::fixed << std::setprecision(2) << p.duration.sum << " s total\n";
+            out.unsetf(std::ios::fixed);
+        }
+    }
+    return out.str();
+}
+
+bool Metrics::write(const std::string& path) const {
+    std::string temp = path + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file << toOpenMetrics();
+        if (!file) {
+            std::remove(temp.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
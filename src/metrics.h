@@ -0,0 +1,88 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Counters and latency histograms for API calls and subprocesses
+ *
+ * GitHubClient records every HTTP attempt, cache lookup and retry here, and
+ * GitUtils records every git/ssh subprocess. The process-wide instance()
+ * outlives individual clients, so the REPL `stats` command and --metrics
+ * report the whole session or run.
+ */
+class Metrics {
+public:
+    /**
+     * @brief Cumulative-on-render histogram over constants::METRICS_LATENCY_BUCKETS
+     */
+    struct Histogram {
+        std::vector<uint64_t> buckets;  // Per-bucket counts, last one is +Inf
+        double sum = 0;
+        uint64_t count = 0;
+
+        Histogram();
+        void observe(double seconds);
+        double quantile(double q) const;  // Upper bound of the bucket holding q
+    };
+
+    Metrics() = default;
+    static Metrics& instance();
+
+    /**
+     * @brief Records one HTTP attempt
+     * @param seconds Time from sending the request to the end of the response
+     * @param retry True for the second and later attempts of one call
+     */
+    void recordRequest(const std::string& method, const std::string& path, int status, double seconds,
+                       size_t bytesIn, size_t bytesOut, bool retry);
+    void recordCacheLookup(bool hit);
+    void recordSubprocess(const std::string& command, double seconds);
+
+    /**
+     * @brief Groups API paths by route: query dropped, owner and name replaced
+     */
+    static std::string endpoint(const std::string& path);
+
+    uint64_t requests() const;
+    uint64_t retries() const;
+    uint64_t cacheHits() const;
+    uint64_t cacheMisses() const;
+    uint64_t subprocesses() const;
+
+    std::string toOpenMetrics() const;
+    std::string summary() const;
+
+    /**
+     * @brief Writes toOpenMetrics() atomically (temp file and rename), as the
+     *        node_exporter textfile collector expects
+     */
+    bool write(const std::string& path) const;
+
+private:
+    struct Endpoint {
+        std::map<std::pair<std::string, int>, uint64_t> byMethodStatus;
+        Histogram latency;
+        uint64_t retries = 0;
+        uint64_t bytesIn = 0;
+        uint64_t bytesOut = 0;
+    };
+
+    struct Subprocess {
+        Histogram duration;
+    };
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Endpoint> endpoints_;
+    std::map<std::string, Subprocess> subprocesses_;
+    uint64_t cacheHits_ = 0;
+    uint64_t cacheMisses_ = 0;
+};
+
+#endif
@@ -0,0 +1,184 @@
+/**
+ * @file output.cpp
+ * @brief Buffered json, ndjson and tsv output for --format
+ *
+ * The human output writes each field with its own std::cout insertion and
+ * wraps it in colors, which scripts had to scrape. Machine-readable records
+ * are built here in one buffer and handed to the stream in large writes.
+ */
+
+#include "output.h"
+#include "constants.h"
+#include "repo_list.h"
+#include <cstdio>
+
+namespace {
+
+void appendJsonString(std::string& out, std::string_view value) {
+    out += '"';
+    for (char c : value) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                    out += escaped;
+                } else {
+                    out += c;  // UTF-8 passes through unchanged
+                }
+        }
+    }
+    out += '"';
+}
+
+void appendTsvField(std::string& out, std::string_view value) {
+    for (char c : value) {
+        switch (c) {
+            case '\t': out += "\\t"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\\': out += "\\\\"; break;
+            default:   out += c;
+        }
+    }
+}
+
+}  // namespace
+
+std::optional<OutputFormat> parseOutputFormat(const std::string& name) {
+    if (name == "text") return OutputFormat::Text;
+    if (name == "json") return OutputFormat::Json;
+    if (name == "ndjson") return OutputFormat::Ndjson;
+    if (name == "tsv") return OutputFormat::Tsv;
+    return std::nullopt;
+}
+
+const char* outputFormatName(OutputFormat format) {
+    switch (format) {
+        case OutputFormat::Json:   return "json";
+        case OutputFormat::Ndjson: return "ndjson";
+        case OutputFormat::Tsv:    return "tsv";
+        default:                   return "text";
+    }
+}
+
+OutputWriter::OutputWriter(OutputFormat format, std::ostream& out) : format_(format), out_(out) {
+    buffer_.reserve(constants::OUTPUT_BUFFER_SIZE);
+}
+
+OutputWriter::~OutputWriter() {
+    finish();
+}
+
+void OutputWriter::beginRecord() {
+    fields_ = 0;
+    recordStart_ = buffer_.size();
+    if (format_ == OutputFormat::Json) {
+        buffer_ += records_ == 0 ? "[\n" : ",\n";
+    }
+    if (format_ == OutputFormat::Json || format_ == OutputFormat::Ndjson) {
+        buffer_ += '{';
+    }
+}
+
+/**
+ * @brief Starts a field: its separator and, in JSON, its key; in TSV the
+ *        key only goes into the header of the first record
+ */
+void OutputWriter::key(std::string_view name) {
+    if (format_ == OutputFormat::Tsv) {
+        if (fields_ > 0) buffer_ += '\t';
+        if (records_ == 0) {
+            if (fields_ > 0) header_ += '\t';
+            appendTsvField(header_, name);
+        }
+    } else {
+        if (fields_ > 0) buffer_ += ',';
+        appendJsonString(buffer_, name);
+        buffer_ += ':';
+    }
+    fields_++;
+}
+
+void OutputWriter::appendRaw(std::string_view value) {
+    buffer_.append(value.data(), value.size());
+}
+
+void OutputWriter::field(std::string_view name, std::string_view value) {
+    key(name);
+    if (format_ == OutputFormat::Tsv) {
+        appendTsvField(buffer_, value);
+    } else {
+        appendJsonString(buffer_, value);
+    }
+}
+
+void OutputWriter::field(std::string_view name, bool value) {
+    key(name);
+    appendRaw(value ? "true" : "false");
+}
+
+void OutputWriter::field(std::string_view name, int64_t value) {
+    key(name);
+    appendRaw(std::to_string(value));
+}
+
+void OutputWriter::field(std::string_view name, double value) {
+    key(name);
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.3f", value);
+    appendRaw(text);
+}
+
+void OutputWriter::endRecord() {
+    if (format_ == OutputFormat::Tsv) {
+        if (records_ == 0) {
+            // The header goes in front of the first row, which is already buffered
+            header_ += '\n';
+            buffer_.insert(recordStart_, header_);
+        }
+        buffer_ += '\n';
+    } else {
+        buffer_ += format_ == OutputFormat::Ndjson ? "}\n" : "}";
+    }
+    records_++;
+    if (buffer_.size() >= constants::OUTPUT_BUFFER_SIZE) {
+        flush();
+    }
+}
+
+void OutputWriter::repo(const RepoList& repos, size_t i) {
+    beginRecord();
+    field("owner", repos.owner(i));
+    field("name", repos.name(i));
+    field("private", repos.isPrivate(i));
+    field("description", repos.description(i));
+    field("html_url", repos.htmlUrl(i));
+    field("ssh_url", repos.sshUrl(i));
+    field("updated_at", repos.updatedAt(i));
+    endRecord();
+}
+
+void OutputWriter::flush() {
+    if (!buffer_.empty()) {
+        out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+    out_.flush();
+}
+
+void OutputWriter::finish() {
+    if (finished_) return;
+    finished_ = true;
+    if (format_ == OutputFormat::Json) {
+        buffer_ += records_ == 0 ? "[]\n" : "\n]\n";
+    }
+    flush();
+}
@@ -0,0 +1,84 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+class RepoList;
+
+enum class OutputFormat {
+    Text,    // Human-readable, with colors (default)
+    Json,    // One JSON array of records
+    Ndjson,  // One JSON object per line
+    Tsv      // Header line, then one tab-separated row per record
+};
+
+std::optional<OutputFormat> parseOutputFormat(const std::string& name);
+const char* outputFormatName(OutputFormat format);
+
+/**
+ * @brief Buffered writer for the machine-readable --format modes
+ *
+ * Every command emits flat records of the same fields, in the same order,
+ * which is what makes a TSV header possible: it is taken from the first
+ * record. Records are built in one buffer and written to the stream when it
+ * passes constants::OUTPUT_BUFFER_SIZE, on flush() and on finish(), so a
+ * listing costs a few large writes instead of one per field.
+ *
+ * Strings are escaped for the format: JSON string escapes, or backslash
+ * escapes for tab, newline, carriage return and backslash in TSV. Not
+ * thread-safe; callers emitting from several threads serialize themselves.
+ */
+class OutputWriter {
+public:
+    explicit OutputWriter(OutputFormat format, std::ostream& out);
+    ~OutputWriter();
+
+    OutputWriter(const OutputWriter&) = delete;
+    OutputWriter& operator=(const OutputWriter&) = delete;
+
+    OutputFormat format() const { return format_; }
+
+    void beginRecord();
+    void field(std::string_view key, std::string_view value);
+    void field(std::string_view key, const char* value) { field(key, std::string_view(value)); }
+    void field(std::string_view key, bool value);
+    void field(std::string_view key, int64_t value);
+    void field(std::string_view key, double value);
+    void endRecord();
+
+    /**
+     * @brief One listing record: owner, name, private, description, URLs, update time
+     */
+    void repo(const RepoList& repos, size_t i);
+
+    /**
+     * @brief Writes out the buffered records, e.g. after each listing page
+     */
+    void flush();
+
+    /**
+     * @brief Closes the JSON array (an empty one if nothing was written) and flushes;
+     *        called by the destructor if needed
+     */
+    void finish();
+
+private:
+    void key(std::string_view name);
+    void appendRaw(std::string_view value);
+
+    OutputFormat format_;
+    std::ostream& out_;
+    std::string buffer_;
+    std::string header_;      // TSV column names of the record in progress
+    size_t records_ = 0;
+    size_t fields_ = 0;       // Fields in the record in progress
+    size_t recordStart_ = 0;  // Where the record in progress starts in buffer_
+    bool finished_ = false;
+};
+
+#endif
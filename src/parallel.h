@@ -0,0 +1,40 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Runs fn(0) .. fn(count - 1) on at most maxParallel threads
+ *
+ * Workers pull the next index from a shared counter, so slow items do not
+ * hold up the rest. The calling thread acts as one of the workers and the
+ * call returns once every index has been processed. fn must not throw.
+ */
+template <typename Fn>
+void parallelFor(size_t count, size_t maxParallel, Fn&& fn) {
+    if (count == 0) return;
+    size_t workers = std::min(count, std::max<size_t>(1, maxParallel));
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            fn(i);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (size_t w = 1; w < workers; w++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+#endif
@@ -0,0 +1,195 @@
+/**
+ * @file rate_limiter.cpp
+ * @brief Rate-limit-aware admission control for GitHub API requests
+ *
+ * GitHub enforces a primary budget (reported in X-RateLimit-* headers) and
+ * secondary limits on concurrency and content creation (reported as 403/429,
+ * usually with Retry-After). This scheduler:
+ * - holds requests while the primary budget is exhausted (up to a cap)
+ * - pauses every request after a secondary-limit response, with jitter
+ * - grows the concurrent request window by 1/window per success and halves
+ *   it on each throttle (AIMD)
+ * - spaces content-creating requests at least constants::API_MUTATION_INTERVAL_MS
+ *   apart (adjustable with setMutationInterval)
+ */
+
+#include "rate_limiter.h"
+#include "constants.h"
+#include <algorithm>
+#include <ctime>
+
+using Clock = std::chrono::steady_clock;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+namespace {
+
+int parseInt(const std::string& value, int fallback) {
+    try {
+        return value.empty() ? fallback : std::stoi(value);
+    } catch (...) {
+        return fallback;
+    }
+}
+
+std::int64_t parseInt64(const std::string& value, std::int64_t fallback) {
+    try {
+        return value.empty() ? fallback : std::stoll(value);
+    } catch (...) {
+        return fallback;
+    }
+}
+
+}  // namespace
+
+RateLimiter::Permit::~Permit() {
+    if (limiter_) {
+        limiter_->release();
+    }
+}
+
+RateLimiter::RateLimiter(int initialConcurrency, int maxConcurrency)
+    : maxConcurrency_(std::max(1, maxConcurrency)),
+      window_(std::clamp(initialConcurrency, 1, std::max(1, maxConcurrency))),
+      mutationInterval_(constants::API_MUTATION_INTERVAL_MS),
+      rng_(std::random_device{}()) {}
+
+/**
+ * @brief Blocks until a request may be sent
+ * @param mutating true for requests that create or change content
+ * @return Permit that frees the request slot when destroyed
+ */
+RateLimiter::Permit RateLimiter::acquire(bool mutating) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        auto now = Clock::now();
+        auto wakeAt = now;
+
+        if (pausedUntil_ > wakeAt) wakeAt = pausedUntil_;
+        if (mutating && nextMutation_ > wakeAt) wakeAt = nextMutation_;
+
+        // Primary budget exhausted: wait for the reset unless it is too far away,
+        // in which case the request goes out and fails fast.
+        std::int64_t untilReset = resetAt_ - static_cast<std::int64_t>(std::time(nullptr));
+        if (remaining_ == 0 && untilReset > 0 && untilReset <= constants::API_MAX_RATE_LIMIT_WAIT) {
+            wakeAt = std::max(wakeAt, now + seconds(untilReset));
+        }
+
+        bool slotFree = inFlight_ < std::max(1, static_cast<int>(window_));
+        if (wakeAt <= now && slotFree) {
+            inFlight_++;
+            if (remaining_ > 0) remaining_--;
+            if (mutating) nextMutation_ = now + mutationInterval_;
+            return Permit(this);
+        }
+
+        if (wakeAt > now) {
+            cv_.wait_until(lock, wakeAt);
+        } else {
+            cv_.wait(lock);
+        }
+    }
+}
+
+void RateLimiter::release() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        inFlight_--;
+    }
+    cv_.notify_all();
+}
+
+/**
+ * @brief Updates the budget from a response and decides whether to retry
+ * @param status HTTP status, or -1 for a network error
+ * @param headers Rate-limit headers of the response
+ * @param body Response body, checked for GitHub's secondary-limit message
+ * @param idempotent true if the request is safe to repeat after a network error
+ * @param attempt Zero-based attempt number, for exponential backoff
+ * @return Delay before retrying, or nullopt if the request should not be retried
+ */
+std::optional<milliseconds> RateLimiter::record(int status, const RateLimitHeaders& headers,
+                                                const std::string& body, bool idempotent, int attempt) {
+    std::optional<milliseconds> retryIn;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // GraphQL has its own budget; only the REST (core) one gates requests
+        if (headers.resource.empty() || headers.resource == "core") {
+            limit_ = parseInt(headers.limit, limit_);
+            remaining_ = parseInt(headers.remaining, remaining_);
+            resetAt_ = parseInt64(headers.reset, resetAt_);
+        }
+
+        bool rateLimited = status == 429 ||
+            (status == 403 && (headers.remaining == "0" || !headers.retryAfter.empty() ||
+                               body.find("rate limit") != std::string::npos));
+        bool transient = status == -1 || status == 502 || status == 503 || status == 504;
+
+        if (rateLimited) {
+            window_ = std::max(1.0, window_ / 2);
+
+            // Per GitHub: honour Retry-After, else wait for the reset when the
+            // primary budget is spent, else back off from at least a minute.
+            milliseconds wait;
+            std::int64_t untilReset = resetAt_ - static_cast<std::int64_t>(std::time(nullptr));
+            if (!headers.retryAfter.empty()) {
+                wait = seconds(parseInt(headers.retryAfter, 60));
+            } else if (remaining_ == 0 && untilReset > 0) {
+                wait = seconds(untilReset);
+            } else {
+                wait = seconds(60) * (1 << std::min(attempt, 4));
+            }
+            if (wait <= seconds(constants::API_MAX_RATE_LIMIT_WAIT)) {
+                wait += jitter(milliseconds(1000));
+                pausedUntil_ = std::max(pausedUntil_, Clock::now() + wait);
+                retryIn = wait;
+            }
+        } else if (transient && idempotent) {
+            milliseconds base = milliseconds(constants::API_RETRY_BASE_MS) * (1 << std::min(attempt, 6));
+            retryIn = base / 2 + jitter(base / 2);
+        } else if (status >= 200 && status < 500) {
+            window_ = std::min(static_cast<double>(maxConcurrency_), window_ + 1.0 / window_);
+        }
+    }
+    cv_.notify_all();
+    return retryIn;
+}
+
+/**
+ * @brief Returns the current budget and scheduler state
+ */
+RateLimitStatus RateLimiter::status() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RateLimitStatus s;
+    s.limit = limit_;
+    s.remaining = remaining_;
+    s.resetAt = resetAt_;
+    s.concurrency = std::max(1, static_cast<int>(window_));
+    s.inFlight = inFlight_;
+    auto now = Clock::now();
+    if (pausedUntil_ > now) {
+        s.pausedFor = std::chrono::duration_cast<milliseconds>(pausedUntil_ - now);
+    }
+    return s;
+}
+
+/**
+ * @brief Sets the minimum spacing between content-creating requests
+ */
+void RateLimiter::setMutationInterval(milliseconds interval) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        mutationInterval_ = interval;
+        nextMutation_ = Clock::time_point{};
+    }
+    cv_.notify_all();
+}
+
+/**
+ * @brief Uniform random delay in [0, upTo]; caller must hold mutex_
+ */
+milliseconds RateLimiter::jitter(milliseconds upTo) {
+    if (upTo.count() <= 0) return milliseconds(0);
+    std::uniform_int_distribution<long long> dist(0, upTo.count());
+    return milliseconds(dist(rng_));
+}
@@ -0,0 +1,85 @@
+#ifndef RATE_LIMITER_H
+#define RATE_LIMITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+
+/**
+ * @brief Snapshot of the rate-limit budget, for callers that pace bulk work
+ *
+ * limit and remaining are -1 until the first response has been seen.
+ */
+struct RateLimitStatus {
+    int limit = -1;
+    int remaining = -1;
+    std::int64_t resetAt = 0;      // Unix time the primary budget refills
+    int concurrency = 0;           // Current AIMD request window
+    int inFlight = 0;
+    std::chrono::milliseconds pausedFor{0};  // Remaining secondary-limit pause
+};
+
+/**
+ * @brief Rate-limit headers of one response, looked up case-insensitively
+ */
+struct RateLimitHeaders {
+    std::string limit;
+    std::string remaining;
+    std::string reset;
+    std::string retryAfter;
+    std::string resource;  // X-RateLimit-Resource: "core", "graphql", ...
+};
+
+/**
+ * @brief Admission control for GitHub API requests
+ *
+ * Tracks the primary budget (X-RateLimit-*) and secondary-limit pauses
+ * (Retry-After, 403/429), adapts the number of concurrent requests with AIMD,
+ * and spaces out content-creating requests as GitHub recommends.
+ */
+class RateLimiter {
+public:
+    class Permit {
+    public:
+        explicit Permit(RateLimiter* limiter) : limiter_(limiter) {}
+        Permit(Permit&& other) noexcept : limiter_(other.limiter_) { other.limiter_ = nullptr; }
+        Permit(const Permit&) = delete;
+        Permit& operator=(const Permit&) = delete;
+        Permit& operator=(Permit&&) = delete;
+        ~Permit();
+
+    private:
+        RateLimiter* limiter_;
+    };
+
+    RateLimiter(int initialConcurrency, int maxConcurrency);
+
+    Permit acquire(bool mutating);
+    std::optional<std::chrono::milliseconds> record(int status, const RateLimitHeaders& headers,
+                                                    const std::string& body, bool idempotent, int attempt);
+    RateLimitStatus status() const;
+    void setMutationInterval(std::chrono::milliseconds interval);
+
+private:
+    void release();
+    std::chrono::milliseconds jitter(std::chrono::milliseconds upTo);
+
+    const int maxConcurrency_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    double window_;
+    int inFlight_ = 0;
+    int limit_ = -1;
+    int remaining_ = -1;
+    std::int64_t resetAt_ = 0;
+    std::chrono::steady_clock::time_point pausedUntil_{};
+    std::chrono::steady_clock::time_point nextMutation_{};
+    std::chrono::milliseconds mutationInterval_;
+    std::mt19937 rng_;
+};
+
+#endif
@@ -0,0 +1,335 @@
+/**
+ * @file reconcile.cpp
+ * @brief Declarative bulk mode: bring the account in line with a manifest
+ *
+ * The manifest lists the desired repositories. planReconcile() diffs it
+ * against the current listing and emits only the calls that change
+ * something; applyReconcile() runs them on a bounded number of workers, all
+ * sharing the client's connection pool and rate limiter.
+ */
+
+#include "reconcile.h"
+#include "github.h"
+#include "parallel.h"
+#include "repo_index.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+using json = nlohmann::json;
+
+namespace {
+
+std::string lower(const std::string& s) {
+    std::string out = s;
+    std::transform(out.begin(), out.end(), out.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return out;
+}
+
+bool validName(const std::string& name) {
+    if (name.empty() || name.length() > 100) return false;
+    for (char c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_' && c != '.') return false;
+    }
+    return true;
+}
+
+bool parseEntry(const json& item, size_t index, ManifestEntry& entry, std::string& error) {
+    std::string where = "repositories[" + std::to_string(index) + "]";
+    if (item.is_string()) {
+        entry.name = item.get<std::string>();
+    } else if (item.is_object()) {
+        if (!item.contains("name") || !item["name"].is_string()) {
+            error = where + ": missing \"name\"";
+            return false;
+        }
+        entry.name = item["name"].get<std::string>();
+
+        if (item.contains("description")) {
+            const auto& d = item["description"];
+            if (d.is_null()) {
+                entry.description = "";
+            } else if (d.is_string()) {
+                entry.description = d.get<std::string>();
+            } else {
+                error = where + ": \"description\" must be a string";
+                return false;
+            }
+        }
+
+        if (item.contains("visibility")) {
+            std::string v = item["visibility"].is_string() ? item["visibility"].get<std::string>() : "";
+            if (v == "private") {
+                entry.isPrivate = true;
+            } else if (v == "public") {
+                entry.isPrivate = false;
+            } else {
+                error = where + ": \"visibility\" must be \"public\" or \"private\"";
+                return false;
+            }
+        } else if (item.contains("private")) {
+            if (!item["private"].is_boolean()) {
+                error = where + ": \"private\" must be true or false";
+                return false;
+            }
+            entry.isPrivate = item["private"].get<bool>();
+        }
+
+        if (item.contains("state")) {
+            std::string st = item["state"].is_string() ? item["state"].get<std::string>() : "";
+            if (st == "present") {
+                entry.present = true;
+            } else if (st == "absent") {
+                entry.present = false;
+            } else {
+                error = where + ": \"state\" must be \"present\" or \"absent\"";
+                return false;
+            }
+        }
+    } else {
+        error = where + ": expected an object or a name";
+        return false;
+    }
+
+    if (!validName(entry.name)) {
+        error = where + ": invalid repository name '" + entry.name + "'";
+        return false;
+    }
+    if (entry.description && entry.description->length() > 350) {
+        error = where + ": description too long (max 350 characters)";
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+// ============================================================================
+// Manifest
+// ============================================================================
+
+/**
+ * @brief Parses a manifest
+ * @param text JSON: {"repositories": [...]} or a bare array
+ * @param entries Receives the entries in manifest order
+ * @param error Receives a description of the first problem found
+ * @return false if the manifest is malformed
+ *
+ * Each entry is a repository name or an object with "name" and optional
+ * "description", "visibility" ("public"/"private") and "state"
+ * ("present"/"absent", default present).
+ */
+bool parseManifest(const std::string& text, std::vector<ManifestEntry>& entries, std::string& error) {
+    json data = json::parse(text, nullptr, false);
+    if (data.is_discarded()) {
+        error = "invalid JSON";
+        return false;
+    }
+
+    const json* list = &data;
+    if (data.is_object()) {
+        if (!data.contains("repositories")) {
+            error = "missing \"repositories\"";
+            return false;
+        }
+        list = &data["repositories"];
+    }
+    if (!list->is_array()) {
+        error = "\"repositories\" must be an array";
+        return false;
+    }
+
+    std::vector<ManifestEntry> parsed;
+    std::unordered_set<std::string> seen;
+    parsed.reserve(list->size());
+    for (size_t i = 0; i < list->size(); i++) {
+        ManifestEntry entry;
+        if (!parseEntry((*list)[i], i, entry, error)) {
+            return false;
+        }
+        if (!seen.insert(lower(entry.name)).second) {
+            error = "repository '" + entry.name + "' is listed more than once";
+            return false;
+        }
+        parsed.push_back(std::move(entry));
+    }
+    entries = std::move(parsed);
+    return true;
+}
+
+/**
+ * @brief Reads and parses a manifest file
+ */
+bool loadManifest(const std::string& path, std::vector<ManifestEntry>& entries, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    if (!parseManifest(buffer.str(), entries, error)) {
+        error = path + ": " + error;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Planning
+// ============================================================================
+
+/**
+ * @brief The indexed repositories owned by login, the only ones apply can change
+ *
+ * The index also holds collaborator and organization repositories, while
+ * every call goes to /repos/{login}/{name}. Planning against those would
+ * skip creating a name that only another owner has, and diff or delete the
+ * wrong repository.
+ */
+std::vector<RepoInfo> ownRepositories(const RepoIndex& index, const std::string& login) {
+    std::string owner = lower(login);
+    std::vector<RepoInfo> repos;
+    for (size_t i = 0; i < index.size(); i++) {
+        RepoView view = index.at(i);
+        if (lower(std::string(view.owner)) == owner) {
+            repos.push_back(view.toRepoInfo());
+        }
+    }
+    return repos;
+}
+
+/**
+ * @brief Computes the minimal set of API calls to reach the desired state
+ * @param desired Manifest entries
+ * @param current The user's own repositories, see ownRepositories()
+ * @return Actions in manifest order; empty if nothing needs to change
+ *
+ * Names match case-insensitively, as on GitHub. Updates only carry the fields
+ * that actually differ, and repositories not named in the manifest are left
+ * alone.
+ */
+std::vector<ReconcileAction> planReconcile(const std::vector<ManifestEntry>& desired,
+                                           const std::vector<RepoInfo>& current) {
+    std::unordered_map<std::string, const RepoInfo*> byName;
+    byName.reserve(current.size());
+    for (const auto& repo : current) {
+        byName.emplace(lower(repo.name), &repo);
+    }
+
+    std::vector<ReconcileAction> actions;
+    for (const auto& entry : desired) {
+        auto it = byName.find(lower(entry.name));
+        const RepoInfo* existing = it == byName.end() ? nullptr : it->second;
+
+        if (!entry.present) {
+            if (existing) {
+                actions.push_back({ReconcileAction::Kind::Delete, existing->name, std::nullopt, std::nullopt});
+            }
+            continue;
+        }
+
+        if (!existing) {
+            actions.push_back({ReconcileAction::Kind::Create, entry.name,
+                               entry.description.value_or(""), entry.isPrivate.value_or(false)});
+            continue;
+        }
+
+        ReconcileAction update{ReconcileAction::Kind::Update, existing->name, std::nullopt, std::nullopt};
+        if (entry.description && *entry.description != existing->description) {
+            update.description = entry.description;
+        }
+        if (entry.isPrivate && *entry.isPrivate != existing->isPrivate) {
+            update.isPrivate = entry.isPrivate;
+        }
+        if (update.description || update.isPrivate) {
+            actions.push_back(std::move(update));
+        }
+    }
+    return actions;
+}
+
+/**
+ * @brief One-line summary of an action, e.g. "update foo (private)"
+ */
+std::string describeAction(const ReconcileAction& action) {
+    std::string text;
+    switch (action.kind) {
+        case ReconcileAction::Kind::Create: text = "create " + action.name; break;
+        case ReconcileAction::Kind::Update: text = "update " + action.name; break;
+        case ReconcileAction::Kind::Delete: text = "delete " + action.name; break;
+    }
+
+    std::vector<std::string> details;
+    if (action.isPrivate) {
+        details.push_back(*action.isPrivate ? "private" : "public");
+    }
+    if (action.description && (action.kind == ReconcileAction::Kind::Update || !action.description->empty())) {
+        details.push_back("description");
+    }
+    if (!details.empty()) {
+        text += " (";
+        for (size_t i = 0; i < details.size(); i++) {
+            text += (i ? ", " : "") + details[i];
+        }
+        text += ")";
+    }
+    return text;
+}
+
+// ============================================================================
+// Execution
+// ============================================================================
+
+/**
+ * @brief Runs the planned calls on at most jobs workers
+ * @param client Authenticated client
+ * @param actions Calls from planReconcile()
+ * @param jobs Maximum number of calls in flight
+ * @param onResult Called as each call completes; calls are serialized
+ * @return Results in the same order as actions
+ *
+ * The client's rate limiter still applies, so creates and deletes are spaced
+ * out as GitHub requires no matter how many workers run.
+ */
+std::vector<ReconcileResult> applyReconcile(GitHubClient& client,
+                                            const std::vector<ReconcileAction>& actions,
+                                            size_t jobs,
+                                            const std::function<void(const ReconcileResult&)>& onResult) {
+    std::vector<ReconcileResult> results(actions.size());
+    std::mutex reportMutex;
+
+    parallelFor(actions.size(), jobs, [&](size_t i) {
+        const auto& action = actions[i];
+        bool ok = false;
+        switch (action.kind) {
+            case ReconcileAction::Kind::Create: {
+                RepoInfo repo;
+                repo.name = action.name;
+                repo.description = action.description.value_or("");
+                repo.isPrivate = action.isPrivate.value_or(false);
+                ok = client.createRepository(repo);
+                break;
+            }
+            case ReconcileAction::Kind::Update:
+                ok = client.updateRepository(action.name, action.description, action.isPrivate);
+                break;
+            case ReconcileAction::Kind::Delete:
+                ok = client.deleteRepository(action.name);
+                break;
+        }
+
+        results[i] = {action, ok};
+        if (onResult) {
+            std::lock_guard<std::mutex> lock(reportMutex);
+            onResult(results[i]);
+        }
+    });
+    return results;
+}
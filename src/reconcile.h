@@ -0,0 +1,59 @@
+#ifndef RECONCILE_H
+#define RECONCILE_H
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct RepoInfo;
+class GitHubClient;
+class RepoIndex;
+
+/**
+ * @brief Desired state of one repository, as declared in a manifest
+ *
+ * Unset description/visibility means "leave as is" for existing repositories
+ * and the defaults (empty, public) for new ones.
+ */
+struct ManifestEntry {
+    std::string name;
+    std::optional<std::string> description;
+    std::optional<bool> isPrivate;
+    bool present = true;
+};
+
+/**
+ * @brief One API call needed to bring the account to the manifest's state
+ */
+struct ReconcileAction {
+    enum class Kind { Create, Update, Delete };
+
+    Kind kind = Kind::Create;
+    std::string name;
+    std::optional<std::string> description;  // Create/Update: value to set
+    std::optional<bool> isPrivate;           // Create/Update: value to set
+};
+
+struct ReconcileResult {
+    ReconcileAction action;
+    bool ok = false;
+};
+
+bool loadManifest(const std::string& path, std::vector<ManifestEntry>& entries, std::string& error);
+bool parseManifest(const std::string& text, std::vector<ManifestEntry>& entries, std::string& error);
+
+std::vector<RepoInfo> ownRepositories(const RepoIndex& index, const std::string& login);
+
+std::vector<ReconcileAction> planReconcile(const std::vector<ManifestEntry>& desired,
+                                           const std::vector<RepoInfo>& current);
+
+std::vector<ReconcileResult> applyReconcile(GitHubClient& client,
+                                            const std::vector<ReconcileAction>& actions,
+                                            size_t jobs,
+                                            const std::function<void(const ReconcileResult&)>& onResult = {});
+
+std::string describeAction(const ReconcileAction& action);
+
+#endif
@@ -2,12 +2,21 @@
 #include "github.h"
 #include "config.h"
 #include "git_utils.h"
+#include "repo_index.h"
+#include "repo_list.h"
+#include "system_check.h"
+#include "constants.h"
+#include "metrics.h"
+#include "trace.h"
 #include <iostream>
 #include <sstream>
 #include <readline/readline.h>
 #include <readline/history.h>
 #include <algorithm>
+#include <chrono>
 #include <cctype>
+#include <string_view>
+#include <strings.h>
 #include <wordexp.h>
 #include <vector>
 
@@ -21,7 +30,7 @@ const std::string YELLOW = "\033[33m";
 const std::string GRAY = "\033[90m";
 
 const std::vector<std::string> COMMANDS = {
-    "create", "c", "list", "l", "delete", "d", "ssh", "s", "auth", "check", "debug", "help", "exit", "quit", "?"
+    "create", "c", "list", "l", "delete", "d", "ssh", "s", "auth", "check", "debug", "stats", "help", "exit", "quit", "?"
 };
 
 std::string getHistoryPath() {
@@ -60,6 +69,10 @@ char* commandGenerator(const char* text, int state) {
 
 char** commandCompletion(const char* text, int start, int end);
 char** pathCompletion(const char* text, int start, int end);
+char** repoNameCompletion(const char* text);
+
+// The REPL's search, for completion; readline callbacks take no context
+const RepoSearch* g_repoSearch = nullptr;
 
 char** commandCompletion(const char* text, int start, int end) {
     if (start == 0) {
@@ -72,6 +85,10 @@ char** commandCompletion(const char* text, int start, int end) {
             before.find("ssh") == 0 || before.find("s ") == 0) {
             return pathCompletion(text, start, end);
         }
+        if ((before.find("list ") == 0 || before.find("l ") == 0 ||
+             before.find("delete ") == 0 || before.find("d ") == 0) && text[0] != '-') {
+            return repoNameCompletion(text);
+        }
     }
     
     return nullptr;
@@ -85,6 +102,14 @@ std::string trim(const std::string& s) {
     return std::string(start, end + 1);
 }
 
+/**
+ * @brief True if an index entry's owner is the login, ignoring case as GitHub does
+ */
+bool isOwnedBy(std::string_view owner, const std::string& login) {
+    return !login.empty() && owner.size() == login.size() &&
+           strncasecmp(owner.data(), login.data(), owner.size()) == 0;
+}
+
 bool isValidRepoName(const std::string& name) {
     if (name.empty() || name.length() > 100) return false;
     for (char c : name) {
@@ -152,6 +177,30 @@ char** pathCompletion(const char* text, int start, int end) {
     
     return matches;
 }
+
+/**
+ * @brief Completes a repository name from the ranked search
+ *
+ * With several candidates the typed text is kept and the candidates are
+ * listed best first, so fuzzy matches that do not share a prefix still show.
+ */
+char** repoNameCompletion(const char* text) {
+    rl_attempted_completion_over = 1;
+    if (!g_repoSearch) return nullptr;
+    auto hits = g_repoSearch->search(text, constants::SEARCH_COMPLETION_LIMIT);
+    if (hits.empty()) return nullptr;
+    
+    char** matches = (char**)malloc((hits.size() + 2) * sizeof(char*));
+    size_t idx = 0;
+    if (hits.size() > 1) {
+        matches[idx++] = strdup(text);
+    }
+    for (const auto& hit : hits) {
+        matches[idx++] = strdup(std::string(g_repoSearch->name(hit.id)).c_str());
+    }
+    matches[idx] = nullptr;
+    return matches;
+}
 }
 
 REPL::REPL() : running_(false), debug_(false) {
@@ -159,6 +208,8 @@ REPL::REPL() : running_(false), debug_(false) {
     using_history();
     loadHistory();
     rl_attempted_completion_function = commandCompletion;
+    rl_sort_completion_matches = 0;
+    g_repoSearch = &search_;
 }
 
 void REPL::printBanner() {
@@ -182,6 +233,7 @@ void REPL::printHelp() {
     std::cout << "  " << GREEN << "ssh" << RESET << "        - Push via SSH only (no API calls)\n";
     std::cout << "  " << GREEN << "check" << RESET << "      - Check system configuration\n";
     std::cout << "  " << GREEN << "debug" << RESET << "      - Toggle debug mode\n";
+    std::cout << "  " << GREEN << "stats" << RESET << "      - Show API and subprocess statistics\n";
     std::cout << "  " << GREEN << "auth" << RESET << "       - Manage authentication\n";
     std::cout << "  " << GREEN << "help" << RESET << "      - Show this help message\n";
     std::cout << "  " << GREEN << "exit" << RESET << "      - Exit the REPL\n";
@@ -201,24 +253,31 @@ void REPL::printHelpCreate() {
 
 void REPL::printHelpList() {
     std::cout << BOLD << "list (l) - List your GitHub repositories\n\n" << RESET;
-    std::cout << "Usage: list [filter]\n\n";
+    std::cout << "Usage: list [--org <a,b,...> | --all-orgs] [filter]\n\n";
     std::cout << "Arguments:\n";
-    std::cout << "  filter   Optional filter to match repository names\n\n";
+    std::cout << "  filter      Optional filter to match repository names\n";
+    std::cout << "  --org       List these organizations' repositories instead\n";
+    std::cout << "  --all-orgs  List the repositories of every organization you belong to\n\n";
     std::cout << "Examples:\n";
     std::cout << "  list                 # List all repositories\n";
     std::cout << "  list foo             # List repos containing 'foo'\n";
+    std::cout << "  list --org a,b api   # Repos of orgs a and b containing 'api'\n";
     std::cout << "  l                    # Short form\n";
-    std::cout << "\n" << GRAY << "Filter matches repositories containing the pattern in their name.\n" << RESET;
+    std::cout << "\n" << GRAY << "Matches names and descriptions, best first: exact name, prefix, substring,\n";
+    std::cout << "then names with a typo or two and description matches. Tab completes names.\n" << RESET;
+    std::cout << GRAY << "Organizations are fetched live and concurrently; the local index covers only your own.\n" << RESET;
 }
 
 void REPL::printHelpDelete() {
     std::cout << BOLD << "delete (d) - Delete a GitHub repository\n\n" << RESET;
-    std::cout << "Usage: delete\n\n";
+    std::cout << "Usage: delete [query]\n\n";
     std::cout << "Opens an interactive menu to select and delete a repository.\n";
-    std::cout << "Requires confirmation by typing the repository name.\n\n";
+    std::cout << "The menu shows the best matches for the query; type more text at the\n";
+    std::cout << "prompt to search again. Requires confirmation by typing the repository name.\n\n";
     std::cout << "Note: Your token must have 'delete_repo' scope.\n\n";
     std::cout << "Examples:\n";
     std::cout << "  delete\n";
+    std::cout << "  delete old-servce     # Typos are forgiven\n";
     std::cout << "  d\n";
 }
 
@@ -255,7 +314,7 @@ void REPL::printHelpCheck() {
     std::cout << "  1. GitHub API Access - Verifies token authentication\n";
     std::cout << "  2. GitHub SSH Access - Tests SSH connectivity\n";
     std::cout << "  3. Local Git Repository - Checks if path is a git repo\n";
-    std::cout << "  4. Token Permissions - Confirms required scopes\n\n";
+    std::cout << "  4. Token Permissions - Reports the token's scopes (repo, delete_repo)\n\n";
     std::cout << "Examples:\n";
     std::cout << "  check              # Check current directory\n";
     std::cout << "  check ./my-project # Check specific path\n\n";
@@ -271,7 +330,7 @@ void REPL::printHelpDebug() {
     std::cout << "Debug mode shows:\n";
     std::cout << "  - API request details (sanitized)\n";
     std::cout << "  - Token info (last 5 chars only)\n";
-    std::cout << "  - HTTP headers and status codes\n\n";
+    std::cout << "  - Status, bytes and timings of each HTTP request\n\n";
     std::cout << "Examples:\n";
     std::cout << "  debug on   # Enable debug output\n";
     std::cout << "  debug off  # Disable debug output\n";
@@ -279,6 +338,21 @@ void REPL::printHelpDebug() {
     std::cout << "CLI equivalent: --debug\n";
 }
 
+void REPL::printHelpStats() {
+    std::cout << BOLD << "stats - Show API and subprocess statistics\n\n" << RESET;
+    std::cout << "Usage: stats [file]\n\n";
+    std::cout << "Arguments:\n";
+    std::cout << "  file  Write the statistics to file in OpenMetrics text format\n\n";
+    std::cout << "Shows, for this session:\n";
+    std::cout << "  - API requests by endpoint and status, with p50/p99 latency\n";
+    std::cout << "  - Retries, cache hits and misses, bytes in and out\n";
+    std::cout << "  - git and ssh subprocesses run and their total time\n\n";
+    std::cout << "Examples:\n";
+    std::cout << "  stats                       # Print statistics\n";
+    std::cout << "  stats /tmp/gh-repo.prom     # Export for node_exporter\n\n";
+    std::cout << "CLI equivalent: --metrics <file>\n";
+}
+
 bool REPL::ensureAuth() {
     auto token = config_->loadToken();
     if (!token.has_value()) {
@@ -288,13 +362,24 @@ bool REPL::ensureAuth() {
         if (!token.has_value()) return false;
     }
     
-    client_ = std::make_unique<GitHubClient>(token.value());
-    if (!client_->authenticate()) {
+    // Keep the existing client (and its pooled connections) while the token is unchanged
+    if (!client_ || client_->token() != token.value()) {
+        client_ = std::make_unique<GitHubClient>(token.value());
+        client_->setDebug(debug_);
+        prefetch_.reset();
+    }
+    std::optional<bool> authenticated;
+    if (prefetch_) {
+        authenticated = prefetched(prefetch_->auth);
+    }
+    if (!authenticated.value_or(false) && !client_->authenticate()) {
         std::cout << RED << "Authentication failed. Please check your token and try again.\n" << RESET;
         cmdAuth();
         token = config_->loadToken();
         if (!token.has_value()) return false;
         client_ = std::make_unique<GitHubClient>(token.value());
+        client_->setDebug(debug_);
+        prefetch_.reset();
         if (!client_->authenticate()) return false;
     }
     
@@ -364,7 +449,7 @@ void REPL::processRepoCreation(const std::string& path) {
             continue;
         }
         
-        if (client_->repositoryExists(repoName)) {
+        if (repositoryExists(repoName)) {
             std::cout << RED << "Repository '" << repoName << "' already exists on your GitHub account.\n" << RESET;
             std::cout << YELLOW << "Please choose a different name.\n" << RESET;
             continue;
@@ -476,42 +561,161 @@ void REPL::cmdCreate() {
     processRepoCreation(path);
 }
 
-void REPL::cmdList(const std::string& filter) {
-    if (!ensureAuth()) return;
+/**
+ * @brief Starts authentication, a connection warm-up and an index sync in the background
+ * 
+ * Called when the REPL opens so the first list, delete or create does not
+ * wait for the TLS handshake and the page walk. Commands pick the results up
+ * through prefetched().
+ */
+void REPL::startPrefetch() {
+    auto token = config_->loadToken();
+    if (!token.has_value()) return;
     
-    auto repos = client_->listRepositories();
+    client_ = std::make_unique<GitHubClient>(token.value());
+    client_->setDebug(debug_);
     
-    if (repos.empty()) {
-        std::cout << YELLOW << "No repositories found.\n" << RESET;
+    Prefetch prefetch;
+    prefetch.token = token.value();
+    prefetch.startedAt = std::chrono::steady_clock::now();
+    prefetch.auth = client_->authenticateAsync().share();
+    client_->warmUpAsync();
+    prefetch.index = client_->syncIndexAsync().share();
+    prefetch_ = std::move(prefetch);
+}
+
+/**
+ * @brief Returns a prefetched result, waiting for it if still in flight
+ * @return The result, or nullopt if it is stale or belongs to another token
+ */
+std::optional<bool> REPL::prefetched(const std::shared_future<bool>& result) {
+    if (!prefetch_ || !client_ || client_->token() != prefetch_->token || !result.valid()) {
+        return std::nullopt;
+    }
+    auto age = std::chrono::steady_clock::now() - prefetch_->startedAt;
+    if (age > std::chrono::seconds(constants::REPL_PREFETCH_TTL)) {
+        prefetch_.reset();
+        return std::nullopt;
+    }
+    if (debug_ && result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        std::cerr << "[DEBUG] Waiting for background prefetch\n";
+    }
+    return result.get();
+}
+
+/**
+ * @brief Checks a name against the prefetched index when fresh, else asks the API
+ * 
+ * Only the user's own entries count: the index also lists collaborator and
+ * organization repositories, whose names do not block a create. This is the
+ * same question the API lookup asks of /repos/{login}/{name}.
+ */
+bool REPL::repositoryExists(const std::string& name) {
+    std::string login = client_->getUsername();
+    if (!login.empty() && prefetch_ && prefetched(prefetch_->index).value_or(false)) {
+        return client_->repoIndex().find(login, name).has_value();
+    }
+    return client_->repositoryExists(name);
+}
+
+bool REPL::loadIndex() {
+    std::optional<bool> synced;
+    if (prefetch_) {
+        synced = prefetched(prefetch_->index);
+    }
+    if (!synced.value_or(false) && !client_->syncIndex()) {
+        if (!client_->repoIndex().loaded()) {
+            std::cout << RED << "Failed to fetch repositories.\n" << RESET;
+            return false;
+        }
+        std::cout << YELLOW << "Could not refresh from GitHub; showing cached repository list.\n" << RESET;
+    }
+    refreshSearch();
+    return true;
+}
+
+/**
+ * @brief Rebuilds the search over the repository index if the index changed
+ * 
+ * Skipped while the startup sync may still be rewriting the index; run()
+ * tries again before every prompt, so completion picks up the synced list.
+ */
+void REPL::refreshSearch() {
+    if (!client_) return;
+    if (prefetch_ && prefetch_->token == client_->token() && prefetch_->index.valid() &&
+        prefetch_->index.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
         return;
     }
+    const RepoIndex& index = client_->repoIndex();
+    if (!index.loaded() || index.generation() == searchGeneration_) return;
     
-    std::vector<RepoInfo> filtered;
-    if (!filter.empty()) {
-        std::string lowerFilter = filter;
-        std::transform(lowerFilter.begin(), lowerFilter.end(), lowerFilter.begin(), ::tolower);
-        for (const auto& repo : repos) {
-            std::string lowerName = repo.name;
-            std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
-            if (lowerName.find(lowerFilter) != std::string::npos) {
-                filtered.push_back(repo);
+    auto start = std::chrono::steady_clock::now();
+    search_.build(index);
+    searchGeneration_ = index.generation();
+    if (debug_) {
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        std::cerr << "[DEBUG] Search index: " << search_.size() << " repositories in " << ms.count() << " ms\n";
+    }
+}
+
+void REPL::cmdList(const std::string& args) {
+    std::istringstream words(args);
+    std::string first;
+    words >> first;
+    if (first == "--org" || first == "--all-orgs") {
+        std::vector<std::string> orgs;
+        if (first == "--org") {
+            std::string list, org;
+            words >> list;
+            std::istringstream names(list);
+            while (std::getline(names, org, ',')) {
+                if (!org.empty()) orgs.push_back(org);
+            }
+            if (orgs.empty()) {
+                std::cout << RED << "Usage: list --org <a,b,...> [filter]\n" << RESET;
+                return;
             }
         }
-    } else {
-        filtered = repos;
+        std::string filter;
+        std::getline(words >> std::ws, filter);
+        cmdListOrgs(std::move(orgs), trim(filter));
+        return;
     }
+    const std::string& filter = args;
+    
+    if (!ensureAuth()) return;
+    if (!loadIndex()) return;
     
-    if (filtered.empty()) {
-        std::cout << YELLOW << "No repositories matching '" << filter << "'.\n" << RESET;
+    const RepoIndex& index = client_->repoIndex();
+    if (index.size() == 0) {
+        std::cout << YELLOW << "No repositories found.\n" << RESET;
         return;
     }
     
+    // Ranked matches are positions in the index; the entries themselves are never copied
+    std::vector<SearchHit> matches;
+    if (!filter.empty()) {
+        matches = search_.search(filter);
+        if (matches.empty()) {
+            std::cout << YELLOW << "No repositories matching '" << filter << "'.\n" << RESET;
+            return;
+        }
+    }
+    size_t total = filter.empty() ? index.size() : matches.size();
+    std::string login = client_->getUsername();
+    
     std::cout << "\n" << BOLD << "Your Repositories:\n" << RESET;
     std::cout << std::string(60, '-') << "\n";
     
-    for (const auto& repo : filtered) {
+    for (size_t n = 0; n < total; n++) {
+        RepoView repo = index.at(filter.empty() ? n : matches[n].id);
         std::string visibility = repo.isPrivate ? RED + "private" + RESET : GREEN + "public" + RESET;
-        std::cout << BOLD << repo.name << RESET << " [" << visibility << "]\n";
+        std::cout << BOLD;
+        // Collaborator and organization repositories are listed too; name their owner
+        if (!repo.owner.empty() && !isOwnedBy(repo.owner, login)) {
+            std::cout << repo.owner << "/";
+        }
+        std::cout << repo.name << RESET << " [" << visibility << "]\n";
         if (!repo.description.empty()) {
             std::cout << GRAY << "  " << repo.description << "\n" << RESET;
         }
@@ -519,19 +723,72 @@ void REPL::cmdList(const std::string& filter) {
         std::cout << "\n";
     }
     
-    std::cout << "Total: " << filtered.size() << " repository(ies)";
+    std::cout << "Total: " << total << " repository(ies)";
     if (!filter.empty()) {
         std::cout << " (filtered: '" << filter << "')";
     }
     std::cout << "\n";
 }
 
-void REPL::cmdDelete() {
+/**
+ * @brief Lists organization repositories straight from the API
+ * @param orgs Organization logins, or empty for every organization of the user
+ */
+void REPL::cmdListOrgs(std::vector<std::string> orgs, const std::string& filter) {
     if (!ensureAuth()) return;
     
-    auto repos = client_->listRepositories();
+    if (orgs.empty()) {
+        orgs = client_->listOrganizations();
+        if (orgs.empty()) {
+            std::cout << YELLOW << "You do not belong to any organization.\n" << RESET;
+            return;
+        }
+    }
     
-    if (repos.empty()) {
+    std::cout << GRAY << "Listing " << orgs.size() << " organization(s)...\n" << RESET;
+    RepoList repos = client_->listOrganizationRepositories(orgs);
+    RepoSearch search;
+    search.build(repos);
+    std::vector<SearchHit> matches = search.search(filter);
+    if (matches.empty()) {
+        if (filter.empty()) {
+            std::cout << YELLOW << "No repositories found.\n" << RESET;
+        } else {
+            std::cout << YELLOW << "No repositories matching '" << filter << "'.\n" << RESET;
+        }
+        return;
+    }
+    
+    std::cout << "\n" << BOLD << "Organization Repositories:\n" << RESET;
+    std::cout << std::string(60, '-') << "\n";
+    
+    for (const SearchHit& hit : matches) {
+        uint32_t i = hit.id;
+        std::string visibility = repos.isPrivate(i) ? RED + "private" + RESET : GREEN + "public" + RESET;
+        std::cout << BOLD;
+        if (!repos.owner(i).empty()) {
+            std::cout << repos.owner(i) << "/";
+        }
+        std::cout << repos.name(i) << RESET << " [" << visibility << "]\n";
+        if (!repos.description(i).empty()) {
+            std::cout << GRAY << "  " << repos.description(i) << "\n" << RESET;
+        }
+        std::cout << GRAY << "  " << repos.htmlUrl(i) << "\n" << RESET;
+        std::cout << "\n";
+    }
+    
+    std::cout << "Total: " << matches.size() << " repository(ies) in " << orgs.size() << " organization(s)";
+    if (!filter.empty()) {
+        std::cout << " (filtered: '" << filter << "')";
+    }
+    std::cout << "\n";
+}
+
+void REPL::cmdDelete(const std::string& query) {
+    if (!ensureAuth()) return;
+    if (!loadIndex()) return;
+    
+    if (search_.size() == 0) {
         std::cout << YELLOW << "No repositories to delete.\n" << RESET;
         return;
     }
@@ -539,15 +796,40 @@ void REPL::cmdDelete() {
     std::cout << "\n" << BOLD + RED + "Delete Repository" << RESET << "\n";
     std::cout << std::string(40, '-') << "\n";
     
-    std::cout << "Select a repository to delete:\n\n";
-    for (size_t i = 0; i < repos.size(); i++) {
-        std::cout << "  " << (i + 1) << ". " << repos[i].name << "\n";
-    }
-    std::cout << "\n  0. Cancel\n";
+    // Copy the names out: deleting rewrites the index and invalidates its views.
+    // Only the user's own repositories are offered; delete acts on /repos/{login}/{name}.
+    std::string login = client_->getUsername();
+    std::vector<std::string> choices;
+    auto offer = [&](const std::string& text) {
+        const RepoIndex& index = client_->repoIndex();
+        bool more = false;
+        choices.clear();
+        for (const auto& hit : search_.search(text)) {
+            if (!isOwnedBy(index.at(hit.id).owner, login)) continue;
+            if (choices.size() == constants::SEARCH_PICKER_LIMIT) {
+                more = true;
+                break;
+            }
+            choices.emplace_back(search_.name(hit.id));
+        }
+        if (choices.empty()) {
+            std::cout << YELLOW << "No repositories matching '" << text << "'.\n" << RESET;
+            return;
+        }
+        std::cout << "Select a repository to delete:\n\n";
+        for (size_t i = 0; i < choices.size(); i++) {
+            std::cout << "  " << (i + 1) << ". " << choices[i] << "\n";
+        }
+        if (more) {
+            std::cout << GRAY << "  ... more; type part of a name to narrow the list\n" << RESET;
+        }
+        std::cout << "\n  0. Cancel\n";
+    };
+    offer(query);
     
     std::string choice;
     while (true) {
-        char* input = readline("Choose (number): ");
+        char* input = readline("Choose (number, or text to search): ");
         if (!input) return;
         choice = trim(input);
         free(input);
@@ -556,14 +838,18 @@ void REPL::cmdDelete() {
             std::cout << "Cancelled.\n";
             return;
         }
+        if (choice.empty() || !std::all_of(choice.begin(), choice.end(), ::isdigit)) {
+            offer(choice);
+            continue;
+        }
         
-        int idx = std::stoi(choice) - 1;
-        if (idx < 0 || idx >= static_cast<int>(repos.size())) {
+        size_t idx = choice.size() > 9 ? 0 : std::stoul(choice);
+        if (idx < 1 || idx > choices.size()) {
             std::cout << RED << "Invalid selection. Try again.\n" << RESET;
             continue;
         }
         
-        std::string repoName = repos[idx].name;
+        std::string repoName = choices[idx - 1];
         std::cout << RED << "\nWARNING: This will permanently delete '" << repoName << "'!\n" << RESET;
         std::cout << "This action cannot be undone.\n\n";
         
@@ -639,77 +925,14 @@ void REPL::cmdCheck(const std::string& path) {
     std::cout << "\n" << BOLD + BLUE + "System Check" << RESET << "\n";
     std::cout << std::string(40, '-') << "\n\n";
     
-    bool allPassed = true;
-    
-    std::cout << BOLD << "1. GitHub API Access\n" << RESET;
     auto token = config_->loadToken();
-    if (!token.has_value()) {
-        std::cout << RED << "   [FAIL] " << RESET << "No GitHub token found\n";
-        std::cout << GRAY << "   -> Set GH_TOKEN environment variable or run 'auth' to add one\n" << RESET;
-        std::cout << GRAY << "   -> See: https://github.com/settings/tokens\n" << RESET;
-        allPassed = false;
-    } else {
+    if (token.has_value() && (!client_ || client_->token() != token.value())) {
         client_ = std::make_unique<GitHubClient>(token.value());
-        if (client_->authenticate()) {
-            std::cout << GREEN << "   [PASS] " << RESET << "Authenticated as: " << client_->getUsername() << "\n";
-        } else {
-            std::cout << RED << "   [FAIL] " << RESET << "Authentication failed - invalid token\n";
-            std::cout << GRAY << "   -> Your token may have expired or been revoked\n" << RESET;
-            std::cout << GRAY << "   -> Generate a new token at: https://github.com/settings/tokens\n" << RESET;
-            allPassed = false;
-        }
+        client_->setDebug(debug_);
+        prefetch_.reset();
     }
-    std::cout << "\n";
-    
-    std::cout << BOLD << "2. GitHub SSH Access\n" << RESET;
-    FILE* pipe = popen("ssh -T git@github.com 2>&1", "r");
-    if (pipe) {
-        char buffer[256] = {0};
-        std::string output;
-        while (fgets(buffer, sizeof(buffer), pipe)) {
-            output += buffer;
-        }
-        pclose(pipe);
-        
-        if (output.find("successfully authenticated") != std::string::npos || 
-            output.find("You've successfully authenticated") != std::string::npos) {
-            std::cout << GREEN << "   [PASS] " << RESET << "SSH access to GitHub working\n";
-        } else {
-            std::cout << RED << "   [FAIL] " << RESET << "SSH access not configured\n";
-            std::cout << GRAY << "   -> Add SSH key to GitHub: Settings > SSH and GPG keys\n" << RESET;
-            std::cout << GRAY << "   -> Run: ssh-add ~/.ssh/id_ed25519\n" << RESET;
-            allPassed = false;
-        }
-    } else {
-        std::cout << RED << "   [FAIL] " << RESET << "Could not test SSH\n";
-        allPassed = false;
-    }
-    std::cout << "\n";
-    
-    std::cout << BOLD << "3. Local Git Repository\n" << RESET;
-    if (GitUtils::isGitRepo(checkPath)) {
-        std::cout << GREEN << "   [PASS] " << RESET << checkPath << " is a git repository\n";
-        
-        if (GitUtils::hasRemote(checkPath, "origin")) {
-            auto remoteUrl = GitUtils::getRemoteUrl(checkPath, "origin");
-            if (remoteUrl.has_value()) {
-                std::cout << GREEN << "   [PASS] " << RESET << "Origin remote: " << remoteUrl.value() << "\n";
-            }
-        } else {
-            std::cout << YELLOW << "   [WARN] " << RESET << "No 'origin' remote configured\n";
-        }
-    } else {
-        std::cout << YELLOW << "   [SKIP] " << RESET << checkPath << " is not a git repository\n";
-    }
-    std::cout << "\n";
-    
-    std::cout << BOLD << "4. Token Permissions\n" << RESET;
-    if (client_) {
-        auto repos = client_->listRepositories();
-        std::cout << GREEN << "   [PASS] " << RESET << "List repositories: OK (" << repos.size() << " repos)\n";
-        std::cout << GRAY << "   Token has 'repo' scope\n" << RESET;
-    }
-    std::cout << "\n";
+    bool allPassed = runSystemCheck(token.has_value() ? client_.get() : nullptr, checkPath,
+                                    "Set GH_TOKEN environment variable or run 'auth' to add one");
     
     std::cout << std::string(40, '-') << "\n";
     if (allPassed) {
@@ -723,9 +946,11 @@ void REPL::cmdCheck(const std::string& path) {
 void REPL::cmdDebug(const std::string& args) {
     if (args == "on") {
         debug_ = true;
+        if (client_) client_->setDebug(true);
         std::cout << GREEN << "Debug mode enabled\n" << RESET;
     } else if (args == "off") {
         debug_ = false;
+        if (client_) client_->setDebug(false);
         std::cout << "Debug mode disabled\n" << RESET;
     } else if (args.empty()) {
         std::cout << "Debug mode is " << (debug_ ? (GREEN + std::string("enabled") + RESET) : "disabled") << "\n";
@@ -734,6 +959,20 @@ void REPL::cmdDebug(const std::string& args) {
     }
 }
 
+void REPL::cmdStats(const std::string& args) {
+    if (!args.empty()) {
+        if (Metrics::instance().write(args)) {
+            std::cout << GREEN << "Statistics written to " << args << "\n" << RESET;
+        } else {
+            std::cout << RED << "Could not write " << args << "\n" << RESET;
+        }
+        return;
+    }
+    std::cout << BOLD << "Session statistics\n" << RESET;
+    std::cout << std::string(40, '-') << "\n";
+    std::cout << Metrics::instance().summary();
+}
+
 void REPL::runCommand(const std::string& input) {
     std::string cmd = trim(input);
     
@@ -759,6 +998,8 @@ void REPL::runCommand(const std::string& input) {
             printHelpCheck();
         } else if (args == "debug") {
             printHelpDebug();
+        } else if (args == "stats") {
+            printHelpStats();
         } else if (args.empty()) {
             printHelp();
         } else {
@@ -770,13 +1011,15 @@ void REPL::runCommand(const std::string& input) {
     } else if (command == "list" || command == "l") {
         cmdList(args);
     } else if (command == "delete" || command == "d") {
-        cmdDelete();
+        cmdDelete(args);
     } else if (command == "ssh" || command == "s") {
         cmdSshOnly();
     } else if (command == "check") {
         cmdCheck(args);
     } else if (command == "debug") {
         cmdDebug(args);
+    } else if (command == "stats") {
+        cmdStats(args);
     } else if (command == "auth") {
         cmdAuth();
     } else if (!command.empty()) {
@@ -787,9 +1030,11 @@ void REPL::runCommand(const std::string& input) {
 
 void REPL::run() {
     printBanner();
+    startPrefetch();
     
     running_ = true;
     while (running_) {
+        refreshSearch();
         char* input = readline("gh-repo> ");
         if (!input) break;
         
@@ -1,8 +1,14 @@
 #ifndef REPL_H
 #define REPL_H
 
+#include "repo_search.h"
+#include <chrono>
+#include <cstdint>
+#include <future>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 class GitHubClient;
 class ConfigManager;
@@ -27,17 +33,38 @@ private:
     void printHelpAuth();
     void printHelpCheck();
     void printHelpDebug();
+    void printHelpStats();
     bool ensureAuth();
+    bool loadIndex();
+    void refreshSearch();
+    void startPrefetch();
+    std::optional<bool> prefetched(const std::shared_future<bool>& result);
+    bool repositoryExists(const std::string& name);
     void cmdCreate();
     void cmdAuth();
-    void cmdList(const std::string& filter = "");
-    void cmdDelete();
+    void cmdList(const std::string& args = "");
+    void cmdListOrgs(std::vector<std::string> orgs, const std::string& filter);
+    void cmdDelete(const std::string& query = "");
     void cmdSshOnly();
     void cmdCheck(const std::string& path = ".");
     void processRepoCreation(const std::string& path);
     void cmdDebug(const std::string& args);
+    void cmdStats(const std::string& args);
+    
+    /**
+     * @brief Work started in the background when the REPL opens
+     */
+    struct Prefetch {
+        std::string token;
+        std::chrono::steady_clock::time_point startedAt;
+        std::shared_future<bool> auth;
+        std::shared_future<bool> index;
+    };
     
     std::unique_ptr<GitHubClient> client_;
+    RepoSearch search_;                // Over client_->repoIndex(), see refreshSearch()
+    std::uint64_t searchGeneration_ = 0;
+    std::optional<Prefetch> prefetch_;
     std::unique_ptr<ConfigManager> config_;
     bool running_;
     bool debug_;
@@ -0,0 +1,348 @@
+/**
+ * @file repo_index.cpp
+ * @brief Memory-mapped repository index
+ *
+ * File layout (version 2, host byte order):
+ * - IndexHeader
+ * - IndexEntry[count], sorted case-insensitively by owner, then name
+ * - String blob; entries refer to it by offset and length
+ *
+ * The index is rewritten as a whole into a temporary file and renamed into
+ * place, so readers either see the old or the new index, never a mix.
+ */
+
+#include "repo_index.h"
+#include "github.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::atomic<std::uint64_t> g_generations{0};
+
+constexpr char INDEX_MAGIC[4] = {'G', 'H', 'R', 'I'};
+constexpr std::uint32_t INDEX_VERSION = 2;  // 2: owner added, entries keyed by owner/name
+constexpr std::uint32_t FLAG_PRIVATE = 1u << 0;
+
+struct IndexHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t count;
+    std::uint32_t reserved;
+    std::int64_t fullSyncTime;
+    char newestUpdatedAt[32];
+};
+
+struct IndexEntry {
+    std::uint32_t ownerOffset, ownerLength;
+    std::uint32_t nameOffset, nameLength;
+    std::uint32_t descriptionOffset, descriptionLength;
+    std::uint32_t htmlUrlOffset, htmlUrlLength;
+    std::uint32_t sshUrlOffset, sshUrlLength;
+    std::uint32_t updatedAtOffset, updatedAtLength;
+    std::uint32_t flags;
+    std::uint32_t reserved;
+};
+
+int compareNoCase(std::string_view a, std::string_view b) {
+    size_t n = std::min(a.size(), b.size());
+    for (size_t i = 0; i < n; i++) {
+        int ca = std::tolower(static_cast<unsigned char>(a[i]));
+        int cb = std::tolower(static_cast<unsigned char>(b[i]));
+        if (ca != cb) return ca < cb ? -1 : 1;
+    }
+    if (a.size() == b.size()) return 0;
+    return a.size() < b.size() ? -1 : 1;
+}
+
+int compareKey(std::string_view ownerA, std::string_view nameA, std::string_view ownerB, std::string_view nameB) {
+    int cmp = compareNoCase(ownerA, ownerB);
+    return cmp != 0 ? cmp : compareNoCase(nameA, nameB);
+}
+
+std::string lowerCase(std::string_view s) {
+    std::string out(s);
+    std::transform(out.begin(), out.end(), out.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return out;
+}
+
+/**
+ * @brief Owner segment of "https://<host>/<owner>/<name>", empty if absent
+ */
+std::string_view ownerFromUrl(std::string_view htmlUrl) {
+    size_t scheme = htmlUrl.find("://");
+    if (scheme == std::string_view::npos) return {};
+    size_t hostEnd = htmlUrl.find('/', scheme + 3);
+    if (hostEnd == std::string_view::npos) return {};
+    size_t ownerEnd = htmlUrl.find('/', hostEnd + 1);
+    if (ownerEnd == std::string_view::npos) return {};
+    return htmlUrl.substr(hostEnd + 1, ownerEnd - hostEnd - 1);
+}
+
+/**
+ * @brief Case-insensitive "owner/name" key for the merge bookkeeping
+ */
+std::string lowerKey(std::string_view owner, std::string_view name) {
+    std::string key = lowerCase(owner);
+    key += '/';
+    key += lowerCase(name);
+    return key;
+}
+
+const IndexHeader* header(const char* data) {
+    return reinterpret_cast<const IndexHeader*>(data);
+}
+
+const IndexEntry* entries(const char* data) {
+    return reinterpret_cast<const IndexEntry*>(data + sizeof(IndexHeader));
+}
+
+}  // namespace
+
+RepoInfo RepoView::toRepoInfo() const {
+    RepoInfo info;
+    info.name = std::string(name);
+    info.description = std::string(description);
+    info.isPrivate = isPrivate;
+    info.htmlUrl = std::string(htmlUrl);
+    info.sshUrl = std::string(sshUrl);
+    info.updatedAt = std::string(updatedAt);
+    return info;
+}
+
+RepoIndex::RepoIndex(const std::string& path) : path_(path) {}
+
+RepoIndex::~RepoIndex() {
+    unmap();
+}
+
+void RepoIndex::unmap() {
+    if (data_) {
+        munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+/**
+ * @brief Maps the index file into memory and validates it
+ * @return false if the file is missing, truncated, or of another version
+ */
+bool RepoIndex::load() {
+    unmap();
+
+    int fd = open(path_.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(IndexHeader)) {
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return false;
+
+    const char* data = static_cast<const char*>(mapped);
+    const IndexHeader* h = header(data);
+    size_t tableEnd = sizeof(IndexHeader) + static_cast<size_t>(h->count) * sizeof(IndexEntry);
+    bool valid = std::memcmp(h->magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0 &&
+                 h->version == INDEX_VERSION && tableEnd <= size;
+
+    // Every string reference must land inside the blob
+    size_t blobSize = valid ? size - tableEnd : 0;
+    for (std::uint32_t i = 0; valid && i < h->count; i++) {
+        const IndexEntry& e = entries(data)[i];
+        const std::uint32_t refs[][2] = {
+            {e.ownerOffset, e.ownerLength}, {e.nameOffset, e.nameLength}, {e.descriptionOffset, e.descriptionLength},
+            {e.htmlUrlOffset, e.htmlUrlLength}, {e.sshUrlOffset, e.sshUrlLength},
+            {e.updatedAtOffset, e.updatedAtLength}
+        };
+        for (const auto& ref : refs) {
+            if (static_cast<size_t>(ref[0]) + ref[1] > blobSize) {
+                valid = false;
+                break;
+            }
+        }
+    }
+
+    if (!valid) {
+        munmap(mapped, size);
+        return false;
+    }
+    data_ = data;
+    size_ = size;
+    generation_ = ++g_generations;
+    return true;
+}
+
+size_t RepoIndex::size() const {
+    return data_ ? header(data_)->count : 0;
+}
+
+RepoView RepoIndex::at(size_t i) const {
+    const IndexEntry& e = entries(data_)[i];
+    const char* blob = data_ + sizeof(IndexHeader) + size() * sizeof(IndexEntry);
+    RepoView view;
+    view.owner = std::string_view(blob + e.ownerOffset, e.ownerLength);
+    view.name = std::string_view(blob + e.nameOffset, e.nameLength);
+    view.description = std::string_view(blob + e.descriptionOffset, e.descriptionLength);
+    view.htmlUrl = std::string_view(blob + e.htmlUrlOffset, e.htmlUrlLength);
+    view.sshUrl = std::string_view(blob + e.sshUrlOffset, e.sshUrlLength);
+    view.updatedAt = std::string_view(blob + e.updatedAtOffset, e.updatedAtLength);
+    view.isPrivate = (e.flags & FLAG_PRIVATE) != 0;
+    return view;
+}
+
+/**
+ * @brief Looks up a repository by owner and name (case-insensitive, like GitHub)
+ * @return Position of the entry, or nullopt if not indexed
+ */
+std::optional<size_t> RepoIndex::find(std::string_view owner, std::string_view name) const {
+    size_t lo = 0, hi = size();
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        RepoView view = at(mid);
+        int cmp = compareKey(view.owner, view.name, owner, name);
+        if (cmp == 0) return mid;
+        if (cmp < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<RepoInfo> RepoIndex::toVector() const {
+    std::vector<RepoInfo> repos;
+    repos.reserve(size());
+    for (size_t i = 0; i < size(); i++) {
+        repos.push_back(at(i).toRepoInfo());
+    }
+    return repos;
+}
+
+std::int64_t RepoIndex::fullSyncTime() const {
+    return data_ ? header(data_)->fullSyncTime : 0;
+}
+
+/**
+ * @brief Newest updated_at timestamp in the index, the incremental sync cursor
+ */
+std::string RepoIndex::newestUpdatedAt() const {
+    if (!data_) return "";
+    const char* s = header(data_)->newestUpdatedAt;
+    return std::string(s, strnlen(s, sizeof(IndexHeader::newestUpdatedAt)));
+}
+
+/**
+ * @brief Replaces the whole index, e.g. after a full listing
+ */
+bool RepoIndex::replace(std::vector<RepoInfo> repos, std::int64_t fullSyncTime) {
+    return write(std::move(repos), fullSyncTime);
+}
+
+/**
+ * @brief Applies an incremental update
+ * @param changed Repositories created or updated since the last sync
+ * @param removed Repositories known to be gone
+ */
+bool RepoIndex::merge(const std::vector<RepoInfo>& changed, const std::vector<RepoKey>& removed) {
+    if (changed.empty() && removed.empty()) return true;
+
+    std::unordered_set<std::string> replaced;
+    for (const auto& r : changed) replaced.insert(lowerKey(ownerFromUrl(r.htmlUrl), r.name));
+    for (const auto& key : removed) replaced.insert(lowerKey(key.owner, key.name));
+
+    std::vector<RepoInfo> repos;
+    repos.reserve(size() + changed.size());
+    for (size_t i = 0; i < size(); i++) {
+        RepoView view = at(i);
+        if (!replaced.count(lowerKey(view.owner, view.name))) {
+            repos.push_back(view.toRepoInfo());
+        }
+    }
+    repos.insert(repos.end(), changed.begin(), changed.end());
+    return write(std::move(repos), fullSyncTime());
+}
+
+bool RepoIndex::write(std::vector<RepoInfo> repos, std::int64_t fullSyncTime) {
+    std::stable_sort(repos.begin(), repos.end(), [](const RepoInfo& a, const RepoInfo& b) {
+        return compareKey(ownerFromUrl(a.htmlUrl), a.name, ownerFromUrl(b.htmlUrl), b.name) < 0;
+    });
+    // Drop duplicates of one owner/name, keeping the last (most recent) occurrence
+    std::vector<RepoInfo> unique;
+    unique.reserve(repos.size());
+    for (auto& r : repos) {
+        if (!unique.empty() && compareKey(ownerFromUrl(unique.back().htmlUrl), unique.back().name,
+                                          ownerFromUrl(r.htmlUrl), r.name) == 0) {
+            unique.back() = std::move(r);
+        } else {
+            unique.push_back(std::move(r));
+        }
+    }
+
+    IndexHeader h{};
+    std::memcpy(h.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    h.version = INDEX_VERSION;
+    h.count = static_cast<std::uint32_t>(unique.size());
+    h.fullSyncTime = fullSyncTime;
+
+    std::string newest;
+    std::vector<IndexEntry> table(unique.size());
+    std::string blob;
+    auto append = [&blob](std::string_view s, std::uint32_t& offset, std::uint32_t& length) {
+        offset = static_cast<std::uint32_t>(blob.size());
+        length = static_cast<std::uint32_t>(s.size());
+        blob += s;
+    };
+    for (size_t i = 0; i < unique.size(); i++) {
+        const RepoInfo& r = unique[i];
+        IndexEntry& e = table[i];
+        append(ownerFromUrl(r.htmlUrl), e.ownerOffset, e.ownerLength);
+        append(r.name, e.nameOffset, e.nameLength);
+        append(r.description, e.descriptionOffset, e.descriptionLength);
+        append(r.htmlUrl, e.htmlUrlOffset, e.htmlUrlLength);
+        append(r.sshUrl, e.sshUrlOffset, e.sshUrlLength);
+        append(r.updatedAt, e.updatedAtOffset, e.updatedAtLength);
+        e.flags = r.isPrivate ? FLAG_PRIVATE : 0;
+        if (r.updatedAt > newest) newest = r.updatedAt;
+    }
+    std::strncpy(h.newestUpdatedAt, newest.c_str(), sizeof(h.newestUpdatedAt) - 1);
+
+    std::error_code ec;
+    fs::create_directories(fs::path(path_).parent_path(), ec);
+    std::string tmpPath = path_ + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        file.write(reinterpret_cast<const char*>(table.data()),
+                   static_cast<std::streamsize>(table.size() * sizeof(IndexEntry)));
+        file.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+        if (!file) {
+            fs::remove(tmpPath, ec);
+            return false;
+        }
+    }
+    fs::rename(tmpPath, path_, ec);
+    if (ec) {
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    return load();
+}
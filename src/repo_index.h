@@ -0,0 +1,89 @@
+#ifndef REPO_INDEX_H
+#define REPO_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct RepoInfo;
+
+/**
+ * @brief Read-only view of one repository inside a mapped RepoIndex
+ *
+ * The views point into the memory mapping and stay valid until the index is
+ * rewritten or destroyed.
+ */
+struct RepoView {
+    std::string_view owner;  // Login from htmlUrl, empty if it has no owner segment
+    std::string_view name;
+    std::string_view description;
+    std::string_view htmlUrl;
+    std::string_view sshUrl;
+    std::string_view updatedAt;
+    bool isPrivate = false;
+
+    RepoInfo toRepoInfo() const;
+};
+
+/**
+ * @brief Identifies an indexed repository: owner login and name
+ */
+struct RepoKey {
+    std::string owner;
+    std::string name;
+};
+
+/**
+ * @brief Persistent, memory-mapped index of the account's repositories
+ *
+ * The listing it is filled from includes repositories of collaborators and
+ * organizations, so the same name can appear under several owners; entries
+ * are keyed by owner and name. The on-disk format is versioned: a fixed
+ * header, a table of fixed-size entries sorted case-insensitively by owner,
+ * then name, then a blob holding every string.
+ * Lookups binary-search the entry table directly in the mapping, so opening
+ * and querying the index costs no parsing or allocation.
+ */
+class RepoIndex {
+public:
+    explicit RepoIndex(const std::string& path);
+    ~RepoIndex();
+    RepoIndex(const RepoIndex&) = delete;
+    RepoIndex& operator=(const RepoIndex&) = delete;
+
+    bool load();
+    bool loaded() const { return data_ != nullptr; }
+    const std::string& path() const { return path_; }
+
+    /**
+     * @brief Changes on every successful load, including the reload after each
+     *        write, and is never reused by another index in the process;
+     *        structures derived from the index rebuild when it changes
+     */
+    std::uint64_t generation() const { return generation_; }
+
+    size_t size() const;
+    RepoView at(size_t i) const;
+    std::optional<size_t> find(std::string_view owner, std::string_view name) const;
+    std::vector<RepoInfo> toVector() const;
+
+    std::int64_t fullSyncTime() const;
+    std::string newestUpdatedAt() const;
+
+    bool replace(std::vector<RepoInfo> repos, std::int64_t fullSyncTime);
+    bool merge(const std::vector<RepoInfo>& changed, const std::vector<RepoKey>& removed);
+
+private:
+    bool write(std::vector<RepoInfo> repos, std::int64_t fullSyncTime);
+    void unmap();
+
+    std::string path_;
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    std::uint64_t generation_ = 0;
+};
+
+#endif
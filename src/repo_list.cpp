@@ -0,0 +1,230 @@
+/**
+ * @file repo_list.cpp
+ * @brief Arena-backed repository listing
+ *
+ * A RepoInfo costs five std::string objects plus a heap block for every
+ * string past the small-string buffer, and two of those strings (the URLs)
+ * repeat the owner and name. For org-scale listings RepoList keeps one
+ * arena, one small entry per repository and the distinct owners only.
+ */
+
+#include "repo_list.h"
+#include "github.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+/**
+ * @brief Splits "https://<host>/<owner>/<name>" into host and owner
+ * @return false if the URL does not have that shape for this name
+ */
+bool splitHtmlUrl(std::string_view url, std::string_view name,
+                  std::string_view& host, std::string_view& owner) {
+    constexpr std::string_view scheme = "https://";
+    if (url.substr(0, scheme.size()) != scheme) return false;
+    url.remove_prefix(scheme.size());
+
+    size_t hostEnd = url.find('/');
+    if (hostEnd == std::string_view::npos || hostEnd == 0) return false;
+    size_t ownerEnd = url.find('/', hostEnd + 1);
+    if (ownerEnd == std::string_view::npos || ownerEnd == hostEnd + 1) return false;
+    if (url.substr(ownerEnd + 1) != name) return false;
+
+    host = url.substr(0, hostEnd);
+    owner = url.substr(hostEnd + 1, ownerEnd - hostEnd - 1);
+    return true;
+}
+
+std::string buildHtmlUrl(std::string_view host, std::string_view owner, std::string_view name) {
+    std::string url;
+    url.reserve(8 + host.size() + owner.size() + name.size() + 2);
+    url.append("https://").append(host).append("/").append(owner).append("/").append(name);
+    return url;
+}
+
+std::string buildSshUrl(std::string_view host, std::string_view owner, std::string_view name) {
+    std::string url;
+    url.reserve(4 + host.size() + owner.size() + name.size() + 6);
+    url.append("git@").append(host).append(":").append(owner).append("/").append(name).append(".git");
+    return url;
+}
+
+template <typename T>
+T clampLength(size_t length) {
+    return static_cast<T>(std::min<size_t>(length, std::numeric_limits<T>::max()));
+}
+
+}  // namespace
+
+void RepoList::reserve(size_t repos, size_t arenaBytes) {
+    entries_.reserve(repos);
+    arena_.reserve(arenaBytes);
+}
+
+/**
+ * @brief Appends one repository, copying its strings into the arena
+ *
+ * Fields longer than the entry's length fields allow (64 KiB, 255 bytes for
+ * updatedAt) are truncated; GitHub's own limits are far below that.
+ */
+void RepoList::add(const RepoInfo& repo) {
+    static_assert(sizeof(Entry) <= 20, "RepoList entries should stay compact");
+    Entry entry{};
+    entry.offset = static_cast<uint32_t>(arena_.size());
+    entry.nameLength = clampLength<uint16_t>(repo.name.size());
+    entry.descriptionLength = clampLength<uint16_t>(repo.description.size());
+    entry.updatedAtLength = clampLength<uint8_t>(repo.updatedAt.size());
+    entry.flags = repo.isPrivate ? PRIVATE : 0;
+
+    arena_.append(repo.name, 0, entry.nameLength);
+    arena_.append(repo.description, 0, entry.descriptionLength);
+    arena_.append(repo.updatedAt, 0, entry.updatedAtLength);
+
+    std::string_view host, owner;
+    if (splitHtmlUrl(repo.htmlUrl, repo.name, host, owner) &&
+        repo.sshUrl == buildSshUrl(host, owner, repo.name)) {
+        std::string key;
+        key.reserve(host.size() + owner.size() + 1);
+        key.append(host).append("/").append(owner);
+        auto [it, inserted] = ownerIds_.try_emplace(std::move(key), static_cast<uint32_t>(owners_.size()));
+        if (inserted) {
+            owners_.push_back({std::string(host), std::string(owner)});
+        }
+        entry.owner = it->second;
+    } else {
+        entry.flags |= VERBATIM_URLS;
+        entry.htmlUrlLength = clampLength<uint16_t>(repo.htmlUrl.size());
+        entry.sshUrlLength = clampLength<uint16_t>(repo.sshUrl.size());
+        arena_.append(repo.htmlUrl, 0, entry.htmlUrlLength);
+        arena_.append(repo.sshUrl, 0, entry.sshUrlLength);
+    }
+    entries_.push_back(entry);
+}
+
+void RepoList::append(const std::vector<RepoInfo>& repos) {
+    entries_.reserve(entries_.size() + repos.size());
+    for (const auto& repo : repos) {
+        add(repo);
+    }
+}
+
+/**
+ * @brief Appends another list's repositories, e.g. a page fetched concurrently
+ *
+ * Copies the other arena in one block and remaps its owners; nothing is
+ * rebuilt per field.
+ */
+void RepoList::append(const RepoList& other) {
+    std::vector<uint32_t> ownerMap(other.owners_.size());
+    for (size_t i = 0; i < other.owners_.size(); i++) {
+        const Owner& owner = other.owners_[i];
+        auto [it, inserted] = ownerIds_.try_emplace(owner.host + "/" + owner.login,
+                                                    static_cast<uint32_t>(owners_.size()));
+        if (inserted) {
+            owners_.push_back(owner);
+        }
+        ownerMap[i] = it->second;
+    }
+
+    uint32_t base = static_cast<uint32_t>(arena_.size());
+    arena_.append(other.arena_);
+    entries_.reserve(entries_.size() + other.entries_.size());
+    for (Entry entry : other.entries_) {
+        entry.offset += base;
+        if (!(entry.flags & VERBATIM_URLS)) {
+            entry.owner = ownerMap[entry.owner];
+        }
+        entries_.push_back(entry);
+    }
+}
+
+/**
+ * @brief Drops every repository from index count on, e.g. a failed partial listing
+ *
+ * Interned owners are kept; they cost a few bytes and may be used again.
+ */
+void RepoList::truncate(size_t count) {
+    if (count >= entries_.size()) return;
+    arena_.resize(entries_[count].offset);
+    entries_.resize(count);
+}
+
+std::string_view RepoList::field(size_t offset, size_t length) const {
+    return std::string_view(arena_).substr(offset, length);
+}
+
+std::string_view RepoList::name(size_t i) const {
+    const Entry& e = entries_[i];
+    return field(e.offset, e.nameLength);
+}
+
+std::string_view RepoList::description(size_t i) const {
+    const Entry& e = entries_[i];
+    return field(e.offset + e.nameLength, e.descriptionLength);
+}
+
+std::string_view RepoList::updatedAt(size_t i) const {
+    const Entry& e = entries_[i];
+    return field(e.offset + e.nameLength + e.descriptionLength, e.updatedAtLength);
+}
+
+bool RepoList::isPrivate(size_t i) const {
+    return (entries_[i].flags & PRIVATE) != 0;
+}
+
+std::string_view RepoList::owner(size_t i) const {
+    const Entry& e = entries_[i];
+    if (e.flags & VERBATIM_URLS) return {};
+    return owners_[e.owner].login;
+}
+
+std::string RepoList::htmlUrl(size_t i) const {
+    const Entry& e = entries_[i];
+    if (e.flags & VERBATIM_URLS) {
+        return std::string(field(e.offset + e.nameLength + e.descriptionLength + e.updatedAtLength,
+                                 e.htmlUrlLength));
+    }
+    const Owner& owner = owners_[e.owner];
+    return buildHtmlUrl(owner.host, owner.login, name(i));
+}
+
+std::string RepoList::sshUrl(size_t i) const {
+    const Entry& e = entries_[i];
+    if (e.flags & VERBATIM_URLS) {
+        return std::string(field(e.offset + e.nameLength + e.descriptionLength + e.updatedAtLength +
+                                 e.htmlUrlLength, e.sshUrlLength));
+    }
+    const Owner& owner = owners_[e.owner];
+    return buildSshUrl(owner.host, owner.login, name(i));
+}
+
+RepoInfo RepoList::at(size_t i) const {
+    RepoInfo repo;
+    repo.name = std::string(name(i));
+    repo.description = std::string(description(i));
+    repo.isPrivate = isPrivate(i);
+    repo.htmlUrl = htmlUrl(i);
+    repo.sshUrl = sshUrl(i);
+    repo.updatedAt = std::string(updatedAt(i));
+    return repo;
+}
+
+std::vector<RepoInfo> RepoList::toVector() const {
+    std::vector<RepoInfo> repos;
+    repos.reserve(size());
+    for (size_t i = 0; i < size(); i++) {
+        repos.push_back(at(i));
+    }
+    return repos;
+}
+
+size_t RepoList::memoryUsage() const {
+    size_t bytes = entries_.capacity() * sizeof(Entry) + arena_.capacity();
+    // Owners are counted by content; there are few of them even on large accounts
+    bytes += owners_.capacity() * sizeof(Owner);
+    for (const auto& [key, id] : ownerIds_) {
+        bytes += sizeof(std::pair<const std::string, uint32_t>) + 2 * sizeof(void*) + 2 * key.size();
+    }
+    return bytes;
+}
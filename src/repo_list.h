@@ -0,0 +1,84 @@
+#ifndef REPO_LIST_H
+#define REPO_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct RepoInfo;
+
+/**
+ * @brief Compact in-memory repository listing for very large accounts
+ *
+ * Names, descriptions and update times are packed back to back in one
+ * arena; each repository adds a 20-byte entry instead of a RepoInfo's five
+ * strings. The web and SSH URLs are not stored: they are rebuilt from the
+ * interned host/owner pair and the name, which is what GitHub's URLs are
+ * made of. URLs that do not follow that pattern are kept verbatim.
+ *
+ * Accessors return views into the arena, valid until the list is modified
+ * or destroyed.
+ */
+class RepoList {
+public:
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+
+    void reserve(size_t repos, size_t arenaBytes);
+    void add(const RepoInfo& repo);
+    void append(const std::vector<RepoInfo>& repos);
+    void append(const RepoList& other);
+    void truncate(size_t count);
+
+    std::string_view name(size_t i) const;
+    std::string_view description(size_t i) const;
+    std::string_view updatedAt(size_t i) const;
+    bool isPrivate(size_t i) const;
+    /**
+     * @brief Login of the user or organization owning the repository, or
+     *        empty if its URLs were stored verbatim
+     */
+    std::string_view owner(size_t i) const;
+    std::string htmlUrl(size_t i) const;
+    std::string sshUrl(size_t i) const;
+
+    RepoInfo at(size_t i) const;
+    std::vector<RepoInfo> toVector() const;
+
+    /**
+     * @brief Heap bytes held by the entries, arena and owner table
+     */
+    size_t memoryUsage() const;
+
+private:
+    struct Entry {
+        uint32_t offset;             // Name, description, updatedAt, verbatim URLs, back to back
+        uint32_t owner;              // Index into owners_, unused with VERBATIM_URLS
+        uint16_t nameLength;
+        uint16_t descriptionLength;
+        uint16_t htmlUrlLength;      // Only with VERBATIM_URLS
+        uint16_t sshUrlLength;       // Only with VERBATIM_URLS
+        uint8_t updatedAtLength;
+        uint8_t flags;
+    };
+
+    static constexpr uint8_t PRIVATE = 1;
+    static constexpr uint8_t VERBATIM_URLS = 2;
+
+    struct Owner {
+        std::string host;   // e.g. github.com
+        std::string login;
+    };
+
+    std::string_view field(size_t offset, size_t length) const;
+
+    std::vector<Entry> entries_;
+    std::string arena_;
+    std::vector<Owner> owners_;
+    std::unordered_map<std::string, uint32_t> ownerIds_;  // "host/login" -> index
+};
+
+#endif
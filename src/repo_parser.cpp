@@ -0,0 +1,428 @@
+/**
+ * @file repo_parser.cpp
+ * @brief Streaming decoders for GitHub repository JSON (REST and GraphQL)
+ *
+ * A page of /user/repos is roughly 600 KB of JSON, of which RepoInfo needs a
+ * handful of top-level fields per repository. The SAX handler below fills
+ * RepoInfo directly as the tokens stream past and ignores everything nested
+ * deeper (owner, permissions, license, ...), so no DOM is ever built.
+ */
+
+#include "repo_parser.h"
+#include "github.h"
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+
+enum class Field { None, Name, Description, Private, HtmlUrl, SshUrl, UpdatedAt };
+
+/**
+ * @brief Maps a REST repository key to the RepoInfo field it fills
+ */
+Field restFieldFor(const std::string& key) {
+    switch (key.size()) {
+        case 4:  if (key == "name") return Field::Name; break;
+        case 7:
+            if (key == "private") return Field::Private;
+            if (key == "ssh_url") return Field::SshUrl;
+            break;
+        case 8:  if (key == "html_url") return Field::HtmlUrl; break;
+        case 10: if (key == "updated_at") return Field::UpdatedAt; break;
+        case 11: if (key == "description") return Field::Description; break;
+        default: break;
+    }
+    return Field::None;
+}
+
+/**
+ * @brief Maps a GraphQL Repository field to the RepoInfo field it fills
+ */
+Field graphqlFieldFor(const std::string& key) {
+    switch (key.size()) {
+        case 3:  if (key == "url") return Field::HtmlUrl; break;
+        case 4:  if (key == "name") return Field::Name; break;
+        case 6:  if (key == "sshUrl") return Field::SshUrl; break;
+        case 9:
+            if (key == "isPrivate") return Field::Private;
+            if (key == "updatedAt") return Field::UpdatedAt;
+            break;
+        case 11: if (key == "description") return Field::Description; break;
+        default: break;
+    }
+    return Field::None;
+}
+
+void assignString(RepoInfo& repo, Field field, std::string&& val) {
+    switch (field) {
+        case Field::Name:        repo.name = std::move(val); break;
+        case Field::Description: repo.description = std::move(val); break;
+        case Field::HtmlUrl:     repo.htmlUrl = std::move(val); break;
+        case Field::SshUrl:      repo.sshUrl = std::move(val); break;
+        case Field::UpdatedAt:   repo.updatedAt = std::move(val); break;
+        default: break;
+    }
+}
+
+/**
+ * @brief SAX handler that decodes repository objects into RepoInfo
+ *
+ * Containers are counted by depth. Repository fields are only picked up at
+ * repoDepth: 2 for a page (array of objects), 1 for a single object.
+ */
+class RepoSaxHandler : public nlohmann::json_sax<json> {
+public:
+    RepoSaxHandler(std::vector<RepoInfo>& out, bool expectArray)
+        : out_(out), expectArray_(expectArray), repoDepth_(expectArray ? 2 : 1) {}
+
+    bool null() override {
+        field_ = Field::None;
+        return true;
+    }
+
+    bool boolean(bool val) override {
+        if (atRepoLevel() && field_ == Field::Private) {
+            current_.isPrivate = val;
+        }
+        field_ = Field::None;
+        return true;
+    }
+
+    bool number_integer(number_integer_t) override { return scalar(); }
+    bool number_unsigned(number_unsigned_t) override { return scalar(); }
+    bool number_float(number_float_t, const string_t&) override { return scalar(); }
+    bool binary(binary_t&) override { return scalar(); }
+
+    bool string(string_t& val) override {
+        if (atRepoLevel()) {
+            assignString(current_, field_, std::move(val));
+        }
+        field_ = Field::None;
+        return true;
+    }
+
+    bool key(string_t& val) override {
+        field_ = atRepoLevel() ? restFieldFor(val) : Field::None;
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        if (depth_ == 0 && expectArray_) {
+            error_ = "response is not an array";
+            return false;
+        }
+        depth_++;
+        field_ = Field::None;
+        if (depth_ == repoDepth_) {
+            current_ = RepoInfo{};
+        }
+        return true;
+    }
+
+    bool end_object() override {
+        if (depth_ == repoDepth_) {
+            out_.push_back(std::move(current_));
+        }
+        depth_--;
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        if (depth_ == 0 && !expectArray_) {
+            error_ = "response is not an object";
+            return false;
+        }
+        depth_++;
+        field_ = Field::None;
+        return true;
+    }
+
+    bool end_array() override {
+        depth_--;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        error_ = ex.what();
+        return false;
+    }
+
+    const std::string& error() const { return error_; }
+
+private:
+    bool atRepoLevel() const { return depth_ == repoDepth_; }
+
+    bool scalar() {
+        if (depth_ == 0) {
+            error_ = expectArray_ ? "response is not an array" : "response is not an object";
+            return false;
+        }
+        field_ = Field::None;
+        return true;
+    }
+
+    std::vector<RepoInfo>& out_;
+    bool expectArray_;
+    int repoDepth_;
+    int depth_ = 0;
+    Field field_ = Field::None;
+    RepoInfo current_;
+    std::string error_;
+};
+
+bool runSax(std::string_view body, std::vector<RepoInfo>& out, bool expectArray, std::string* error) {
+    size_t before = out.size();
+    RepoSaxHandler handler(out, expectArray);
+    bool ok = json::sax_parse(body.begin(), body.end(), &handler);
+    if (!ok) {
+        // Do not hand back a partially decoded page
+        out.erase(out.begin() + static_cast<std::ptrdiff_t>(before), out.end());
+        if (error) {
+            *error = handler.error().empty() ? "invalid JSON" : handler.error();
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief SAX handler for a GraphQL repository connection page
+ *
+ * Expects {"data": {<owner>: {"repositories": {"pageInfo": {...}, "nodes": [...]}}}}
+ * and decodes the nodes straight into RepoInfo. A top-level "errors" array,
+ * or a response without the connection, fails the parse.
+ */
+class GraphQLRepoSaxHandler : public nlohmann::json_sax<json> {
+public:
+    GraphQLRepoSaxHandler(std::vector<RepoInfo>& out, GraphQLPageInfo& page) : out_(out), page_(page) {}
+
+    bool null() override { return scalar(); }
+
+    bool boolean(bool val) override {
+        if (atNode() && field_ == Field::Private) {
+            current_.isPrivate = val;
+        } else if (atPageInfo() && key_ == "hasNextPage") {
+            page_.hasNextPage = val;
+        }
+        return scalar();
+    }
+
+    bool number_integer(number_integer_t) override { return scalar(); }
+    bool number_unsigned(number_unsigned_t) override { return scalar(); }
+    bool number_float(number_float_t, const string_t&) override { return scalar(); }
+    bool binary(binary_t&) override { return scalar(); }
+
+    bool string(string_t& val) override {
+        if (atNode()) {
+            assignString(current_, field_, std::move(val));
+        } else if (atPageInfo() && key_ == "endCursor") {
+            page_.endCursor = std::move(val);
+        } else if (inErrors() && key_ == "message" && errorMessage_.empty()) {
+            errorMessage_ = std::move(val);
+        }
+        return scalar();
+    }
+
+    bool key(string_t& val) override {
+        key_ = std::move(val);
+        field_ = atNode() ? graphqlFieldFor(key_) : Field::None;
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        if (stack_.empty()) {
+            stack_.push_back("");
+            return true;
+        }
+        push();
+        if (atNode()) {
+            current_ = RepoInfo{};
+        } else if (stack_.size() == 4 && stack_[3] == "repositories" && stack_[1] == "data") {
+            sawConnection_ = true;
+        }
+        return true;
+    }
+
+    bool end_object() override {
+        if (atNode()) {
+            out_.push_back(std::move(current_));
+        }
+        stack_.pop_back();
+        key_.clear();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        if (stack_.empty()) {
+            error_ = "response is not an object";
+            return false;
+        }
+        push();
+        return true;
+    }
+
+    bool end_array() override {
+        stack_.pop_back();
+        key_.clear();
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        error_ = ex.what();
+        return false;
+    }
+
+    /**
+     * @brief Failure description once parsing is done, or empty on success
+     */
+    std::string result() const {
+        if (!error_.empty()) return error_;
+        if (sawErrors_) return errorMessage_.empty() ? "GraphQL error" : errorMessage_;
+        if (!sawConnection_) return "response has no repositories connection";
+        return "";
+    }
+
+private:
+    // stack_[0] is the root; deeper entries hold the key (or "[]") of each open container
+    bool atNode() const { return stack_.size() == 6 && stack_[4] == "nodes" && stack_[3] == "repositories"; }
+    bool atPageInfo() const { return stack_.size() == 5 && stack_[4] == "pageInfo" && stack_[3] == "repositories"; }
+    bool inErrors() const { return stack_.size() >= 2 && stack_[1] == "errors"; }
+
+    void push() {
+        bool inArray = !stack_.empty() && key_.empty();
+        stack_.push_back(inArray ? "[]" : key_);
+        if (stack_.size() == 2 && stack_[1] == "errors") {
+            sawErrors_ = true;
+        }
+        key_.clear();
+        field_ = Field::None;
+    }
+
+    bool scalar() {
+        if (stack_.empty()) {
+            error_ = "response is not an object";
+            return false;
+        }
+        key_.clear();
+        field_ = Field::None;
+        return true;
+    }
+
+    std::vector<RepoInfo>& out_;
+    GraphQLPageInfo& page_;
+    std::vector<std::string> stack_;
+    std::string key_;
+    Field field_ = Field::None;
+    RepoInfo current_;
+    bool sawConnection_ = false;
+    bool sawErrors_ = false;
+    std::string errorMessage_;
+    std::string error_;
+};
+
+}  // namespace
+
+/**
+ * @brief Decodes a page of repositories (a JSON array) without building a DOM
+ * @param body Response body
+ * @param out Repositories are appended here
+ * @param error Receives a description of the failure, if any
+ * @return false if the body is not a valid JSON array
+ */
+bool parseRepoPage(std::string_view body, std::vector<RepoInfo>& out, std::string* error) {
+    return runSax(body, out, true, error);
+}
+
+/**
+ * @brief Decodes a single repository object, e.g. a create response
+ */
+bool parseRepoObject(std::string_view body, RepoInfo& out, std::string* error) {
+    std::vector<RepoInfo> repos;
+    if (!runSax(body, repos, false, error) || repos.empty()) {
+        return false;
+    }
+    out = std::move(repos.front());
+    return true;
+}
+
+/**
+ * @brief Decodes one page of a GraphQL repositories connection
+ * @param body Response body of a query selecting repositories { pageInfo nodes }
+ * @param out Repositories are appended here
+ * @param page Receives hasNextPage and endCursor
+ * @param error Receives a description of the failure, including GraphQL errors
+ * @return false if the body is malformed or reports errors
+ */
+bool parseGraphQLRepoPage(std::string_view body, std::vector<RepoInfo>& out,
+                          GraphQLPageInfo& page, std::string* error) {
+    size_t before = out.size();
+    page = GraphQLPageInfo{};
+    GraphQLRepoSaxHandler handler(out, page);
+    json::sax_parse(body.begin(), body.end(), &handler);
+    std::string failure = handler.result();
+    if (!failure.empty()) {
+        out.erase(out.begin() + static_cast<std::ptrdiff_t>(before), out.end());
+        if (error) *error = failure;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief DOM-based page decoder
+ *
+ * The original implementation, kept as the reference the streaming decoder is
+ * tested and benchmarked against.
+ */
+bool parseRepoPageDom(std::string_view body, std::vector<RepoInfo>& out, std::string* error) {
+    try {
+        auto data = json::parse(body.begin(), body.end());
+        if (!data.is_array()) {
+            if (error) *error = "response is not an array";
+            return false;
+        }
+        out.reserve(out.size() + data.size());
+        for (const auto& r : data) {
+            RepoInfo info;
+            info.name = r.value("name", "");
+            // Handle null descriptions safely
+            if (r.contains("description") && !r["description"].is_null()) {
+                info.description = r["description"].get<std::string>();
+            }
+            info.isPrivate = r.value("private", false);
+            info.htmlUrl = r.value("html_url", "");
+            info.sshUrl = r.value("ssh_url", "");
+            info.updatedAt = r.value("updated_at", "");
+            out.push_back(std::move(info));
+        }
+    } catch (const std::exception& e) {
+        if (error) *error = e.what();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes a page of GET /user/orgs into organization logins
+ *
+ * Pages are a few hundred bytes per organization, so the DOM is fine here.
+ */
+bool parseOrgPage(std::string_view body, std::vector<std::string>& logins, std::string* error) {
+    try {
+        auto data = json::parse(body.begin(), body.end());
+        if (!data.is_array()) {
+            if (error) *error = "response is not an array";
+            return false;
+        }
+        for (const auto& org : data) {
+            std::string login = org.value("login", "");
+            if (!login.empty()) {
+                logins.push_back(std::move(login));
+            }
+        }
+    } catch (const std::exception& e) {
+        if (error) *error = e.what();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,25 @@
+#ifndef REPO_PARSER_H
+#define REPO_PARSER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct RepoInfo;
+
+/**
+ * @brief Cursor state of a GraphQL connection page
+ */
+struct GraphQLPageInfo {
+    bool hasNextPage = false;
+    std::string endCursor;
+};
+
+bool parseRepoPage(std::string_view body, std::vector<RepoInfo>& out, std::string* error = nullptr);
+bool parseRepoObject(std::string_view body, RepoInfo& out, std::string* error = nullptr);
+bool parseGraphQLRepoPage(std::string_view body, std::vector<RepoInfo>& out,
+                          GraphQLPageInfo& page, std::string* error = nullptr);
+bool parseRepoPageDom(std::string_view body, std::vector<RepoInfo>& out, std::string* error = nullptr);
+bool parseOrgPage(std::string_view body, std::vector<std::string>& logins, std::string* error = nullptr);
+
+#endif
@@ -0,0 +1,335 @@
+/**
+ * @file repo_search.cpp
+ * @brief Trigram index and ranking behind `list <query>`, completion and the
+ *        delete picker
+ *
+ * Scanning every name with a case-insensitive find costs a pass over the
+ * whole listing per keystroke and cannot forgive typos. The index maps each
+ * trigram to the repositories containing it, so a query touches only the
+ * postings of its own trigrams; the survivors are verified and ranked.
+ */
+
+#include "repo_search.h"
+#include "repo_index.h"
+#include "repo_list.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+constexpr uint32_t TRIGRAM_BITS = 18;                  // Three 6-bit symbols
+constexpr uint32_t TRIGRAM_KEYS = 1u << TRIGRAM_BITS;
+constexpr size_t MAX_QUERY_LENGTH = 64;                // One machine word for the edit distance
+
+/**
+ * @brief Folds a lowercased byte into 6 bits; everything outside
+ *        [a-z0-9-_. ] shares one symbol, which only adds candidates
+ */
+uint32_t symbol(unsigned char c) {
+    if (c >= 'a' && c <= 'z') return c - 'a' + 1;
+    if (c >= '0' && c <= '9') return c - '0' + 27;
+    switch (c) {
+        case '-': return 37;
+        case '_': return 38;
+        case '.': return 39;
+        case ' ': return 40;
+        default: return 41;
+    }
+}
+
+/**
+ * @brief Distinct trigram keys of text, sorted
+ * @param padded Prefix two spaces, so the first characters form trigrams too
+ */
+void collectTrigrams(std::string_view text, bool padded, std::vector<uint32_t>& keys) {
+    keys.clear();
+    uint32_t key = padded ? (symbol(' ') << 6) | symbol(' ') : 0;
+    size_t length = padded ? 2 : 0;
+    for (unsigned char c : text) {
+        key = ((key << 6) | symbol(c)) & (TRIGRAM_KEYS - 1);
+        if (++length >= 3) keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
+
+void appendLower(std::string& out, std::string_view text) {
+    for (unsigned char c : text) {
+        out += static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+    }
+}
+
+bool isSeparator(char c) {
+    return c == '-' || c == '_' || c == '.' || c == ' ';
+}
+
+/**
+ * @brief Fewest edits turning the pattern into any substring of text
+ * @param length Pattern length, 1 to 64
+ * @param peq Per byte, the bit mask of pattern positions holding it
+ *
+ * Myers' bit-parallel algorithm: one column of the edit-distance matrix per
+ * text character, in a handful of word operations.
+ */
+int approximateDistance(std::string_view text, size_t length, const uint64_t* peq) {
+    uint64_t pv = ~0ull;
+    uint64_t mv = 0;
+    uint64_t last = 1ull << (length - 1);
+    int score = static_cast<int>(length);
+    int best = score;
+    for (unsigned char c : text) {
+        uint64_t eq = peq[c];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & last) {
+            score++;
+        } else if (mh & last) {
+            score--;
+        }
+        // No carry into the first row: a match may start anywhere in text
+        ph <<= 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        best = std::min(best, score);
+    }
+    return best;
+}
+
+}  // namespace
+
+void RepoSearch::clear() {
+    docs_.clear();
+    text_.clear();
+}
+
+void RepoSearch::build(const RepoIndex& index) {
+    clear();
+    docs_.reserve(index.size());
+    for (size_t i = 0; i < index.size(); i++) {
+        RepoView repo = index.at(i);
+        add(repo.name, repo.description);
+    }
+    finish();
+}
+
+void RepoSearch::build(const RepoList& repos) {
+    clear();
+    docs_.reserve(repos.size());
+    for (size_t i = 0; i < repos.size(); i++) {
+        add(repos.name(i), repos.description(i));
+    }
+    finish();
+}
+
+void RepoSearch::add(std::string_view name, std::string_view description) {
+    constexpr size_t maxLength = std::numeric_limits<uint16_t>::max();
+    name = name.substr(0, maxLength);
+    description = description.substr(0, maxLength);
+
+    Doc doc;
+    doc.offset = static_cast<uint32_t>(text_.size());
+    doc.nameLength = static_cast<uint16_t>(name.size());
+    doc.descriptionLength = static_cast<uint16_t>(description.size());
+    text_.append(name);
+    appendLower(text_, name);
+    appendLower(text_, description);
+    docs_.push_back(doc);
+}
+
+/**
+ * @brief Builds both posting tables with a counting pass and a filling pass
+ *
+ * Ids come out ascending within each trigram, and nothing is sorted but the
+ * few trigrams of one text at a time.
+ */
+void RepoSearch::finish() {
+    std::vector<uint32_t> keys;
+    auto index = [&](Postings& postings, bool descriptions) {
+        auto text = [&](uint32_t id) { return descriptions ? lowerDescription(id) : lowerName(id); };
+        postings.offsets.assign(TRIGRAM_KEYS + 1, 0);
+        for (uint32_t id = 0; id < docs_.size(); id++) {
+            collectTrigrams(text(id), !descriptions, keys);
+            for (uint32_t key : keys) postings.offsets[key + 1]++;
+        }
+        for (uint32_t key = 0; key < TRIGRAM_KEYS; key++) {
+            postings.offsets[key + 1] += postings.offsets[key];
+        }
+        postings.ids.assign(postings.offsets.back(), 0);
+        std::vector<uint32_t> next(postings.offsets.begin(), postings.offsets.end() - 1);
+        for (uint32_t id = 0; id < docs_.size(); id++) {
+            collectTrigrams(text(id), !descriptions, keys);
+            for (uint32_t key : keys) postings.ids[next[key]++] = id;
+        }
+    };
+    index(names_, false);
+    index(descriptions_, true);
+}
+
+std::string_view RepoSearch::name(uint32_t id) const {
+    const Doc& doc = docs_[id];
+    return std::string_view(text_).substr(doc.offset, doc.nameLength);
+}
+
+std::string_view RepoSearch::lowerName(uint32_t id) const {
+    const Doc& doc = docs_[id];
+    return std::string_view(text_).substr(doc.offset + doc.nameLength, doc.nameLength);
+}
+
+std::string_view RepoSearch::lowerDescription(uint32_t id) const {
+    const Doc& doc = docs_[id];
+    return std::string_view(text_).substr(doc.offset + 2u * doc.nameLength, doc.descriptionLength);
+}
+
+/**
+ * @brief Scores a lowercased name containing the lowercased query as typed,
+ *        0 if it does not
+ */
+int RepoSearch::scoreName(std::string_view name, std::string_view query) const {
+    if (name == query) return EXACT;
+    if (name.substr(0, query.size()) == query) return PREFIX;
+
+    size_t pos = name.find(query);
+    if (pos == std::string_view::npos) return 0;
+    for (; pos != std::string_view::npos; pos = name.find(query, pos + 1)) {
+        if (isSeparator(name[pos - 1])) return WORD;
+    }
+    return SUBSTRING;
+}
+
+/**
+ * @brief Scores a name within maxEdits typos of the query, 0 if it is not
+ */
+int RepoSearch::scoreTypos(std::string_view name, size_t queryLength, int maxEdits,
+                           const uint64_t* peq) const {
+    int edits = approximateDistance(name, queryLength, peq);
+    if (edits > maxEdits) return 0;
+    int score = FUZZY - 100 * edits;
+    // The same match within the first few characters counts as a mistyped prefix
+    std::string_view head = name.substr(0, queryLength + static_cast<size_t>(maxEdits));
+    if (approximateDistance(head, queryLength, peq) == edits) {
+        score += FUZZY_PREFIX;
+    }
+    return score;
+}
+
+std::vector<SearchHit> RepoSearch::search(std::string_view query, size_t limit) const {
+    std::string q;
+    size_t first = query.find_first_not_of(" \t");
+    size_t last = query.find_last_not_of(" \t");
+    if (first != std::string_view::npos) {
+        appendLower(q, query.substr(first, std::min(last - first + 1, MAX_QUERY_LENGTH)));
+    }
+
+    std::vector<SearchHit> hits;
+    uint32_t count = static_cast<uint32_t>(docs_.size());
+    if (q.empty()) {
+        hits.reserve(std::min<size_t>(count, limit));
+        for (uint32_t id = 0; id < count && hits.size() < limit; id++) {
+            hits.push_back({id, 0});
+        }
+        return hits;
+    }
+
+    std::vector<uint32_t> keys;
+    collectTrigrams(q, false, keys);
+    if (keys.empty()) {
+        // Under three characters: no trigram to look up, and too short to say
+        // much about a description, so names are checked directly
+        for (uint32_t id = 0; id < count; id++) {
+            int score = scoreName(lowerName(id), q);
+            if (score > 0) hits.push_back({id, score});
+        }
+    } else {
+        // A text containing the query holds all of its trigrams, so the
+        // shortest posting list of each table covers every match as typed
+        auto rarest = [&keys](const Postings& postings) {
+            uint32_t best = keys.front();
+            for (uint32_t key : keys) {
+                if (postings.offsets[key + 1] - postings.offsets[key] <
+                    postings.offsets[best + 1] - postings.offsets[best]) {
+                    best = key;
+                }
+            }
+            return std::make_pair(postings.ids.data() + postings.offsets[best],
+                                  postings.ids.data() + postings.offsets[best + 1]);
+        };
+        auto [name, nameEnd] = rarest(names_);
+        auto [description, descriptionEnd] = rarest(descriptions_);
+        // Both lists are ascending: merge them so each id is scored once
+        while (name != nameEnd || description != descriptionEnd) {
+            uint32_t id = name == nameEnd ? *description
+                        : description == descriptionEnd ? *name
+                        : std::min(*name, *description);
+            int score = 0;
+            if (name != nameEnd && *name == id) {
+                score = scoreName(lowerName(id), q);
+                ++name;
+            }
+            if (description != descriptionEnd && *description == id) {
+                if (lowerDescription(id).find(q) != std::string_view::npos) {
+                    score = score > 0 ? score + DESCRIPTION_BONUS : DESCRIPTION;
+                }
+                ++description;
+            }
+            if (score > 0) hits.push_back({id, score});
+        }
+    }
+
+    // Typos: roughly one per four characters, at most two, each destroying at
+    // most three of the query's trigrams
+    int maxEdits = q.size() >= 8 ? 2 : q.size() >= 4 ? 1 : 0;
+    if (hits.size() < FUZZY_BELOW && maxEdits > 0) {
+        std::vector<uint8_t> trigramHits(count, 0);
+        for (uint32_t key : keys) {
+            for (uint32_t i = names_.offsets[key]; i < names_.offsets[key + 1]; i++) {
+                trigramHits[names_.ids[i]]++;
+            }
+        }
+        uint64_t peq[256] = {};
+        for (size_t i = 0; i < q.size(); i++) {
+            peq[static_cast<unsigned char>(q[i])] |= 1ull << i;
+        }
+        size_t needed = keys.size() > 3u * maxEdits ? keys.size() - 3u * maxEdits : 1;
+        size_t matched = hits.size();
+        for (uint32_t id = 0; id < count; id++) {
+            if (trigramHits[id] < needed) continue;
+            auto hit = std::find_if(hits.begin(), hits.begin() + static_cast<std::ptrdiff_t>(matched),
+                                    [id](const SearchHit& h) { return h.id == id; });
+            bool found = hit != hits.begin() + static_cast<std::ptrdiff_t>(matched);
+            if (found && hit->score != DESCRIPTION) continue;
+            int score = scoreTypos(lowerName(id), q.size(), maxEdits, peq);
+            if (score == 0) continue;
+            if (found) {
+                hit->score = score + DESCRIPTION_BONUS;
+            } else {
+                hits.push_back({id, score});
+            }
+        }
+    }
+
+    auto better = [this](const SearchHit& a, const SearchHit& b) {
+        if (a.score != b.score) return a.score > b.score;
+        if (docs_[a.id].nameLength != docs_[b.id].nameLength) {
+            return docs_[a.id].nameLength < docs_[b.id].nameLength;
+        }
+        return a.id < b.id;
+    };
+    if (limit < hits.size()) {
+        std::partial_sort(hits.begin(), hits.begin() + static_cast<std::ptrdiff_t>(limit), hits.end(), better);
+        hits.resize(limit);
+    } else {
+        std::sort(hits.begin(), hits.end(), better);
+    }
+    return hits;
+}
+
+size_t RepoSearch::memoryUsage() const {
+    size_t bytes = docs_.capacity() * sizeof(Doc) + text_.capacity();
+    for (const Postings* postings : {&names_, &descriptions_}) {
+        bytes += (postings->offsets.capacity() + postings->ids.capacity()) * sizeof(uint32_t);
+    }
+    return bytes;
+}
@@ -0,0 +1,97 @@
+#ifndef REPO_SEARCH_H
+#define REPO_SEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class RepoIndex;
+class RepoList;
+
+/**
+ * @brief One ranked search result
+ */
+struct SearchHit {
+    uint32_t id;   // Position in the RepoIndex or RepoList the search was built from
+    int score;
+};
+
+/**
+ * @brief Ranked, typo-tolerant search over repository names and descriptions
+ *
+ * build() copies the names and lowercased descriptions and indexes their
+ * trigrams, so a query only visits repositories sharing trigrams with it.
+ * Candidates are then scored, best first: exact name, name prefix, name
+ * substring (higher at a word boundary), name within one or two typos
+ * (a bit-parallel edit distance, boosted when the match is at the start),
+ * then description substring. Typos are only considered when fewer than
+ * FUZZY_BELOW repositories match the query as typed, so a common prefix does
+ * not drown its exact matches in near misses.
+ *
+ * The search keeps no references to its source and is safe to query from
+ * several threads; rebuild it when the source changes.
+ */
+class RepoSearch {
+public:
+    // Score bands; ties are broken by shorter name, then source order
+    static constexpr int EXACT = 1000;
+    static constexpr int PREFIX = 900;
+    static constexpr int WORD = 700;
+    static constexpr int SUBSTRING = 600;
+    static constexpr int FUZZY = 400;         // Minus 100 per edit, plus FUZZY_PREFIX
+    static constexpr int FUZZY_PREFIX = 100;
+    static constexpr int DESCRIPTION = 250;       // Description only
+    static constexpr int DESCRIPTION_BONUS = 50;  // Name and description both match
+    static constexpr size_t FUZZY_BELOW = 10;
+
+    void build(const RepoIndex& index);
+    void build(const RepoList& repos);
+
+    size_t size() const { return docs_.size(); }
+    std::string_view name(uint32_t id) const;
+
+    /**
+     * @brief Matches for query, best first
+     * @param limit Maximum number of hits returned
+     * @return Every repository, in source order, for an empty query
+     */
+    std::vector<SearchHit> search(std::string_view query, size_t limit = SIZE_MAX) const;
+
+    /**
+     * @brief Heap bytes held by the copied text and both trigram tables
+     */
+    size_t memoryUsage() const;
+
+private:
+    struct Doc {
+        uint32_t offset;            // Name, lowercased name, lowercased description
+        uint16_t nameLength;
+        uint16_t descriptionLength;
+    };
+
+    /**
+     * @brief Trigram -> document ids, in compressed sparse row form
+     */
+    struct Postings {
+        std::vector<uint32_t> offsets;  // Per trigram key, into ids
+        std::vector<uint32_t> ids;
+    };
+
+    void clear();
+    void add(std::string_view name, std::string_view description);
+    void finish();
+
+    std::string_view lowerName(uint32_t id) const;
+    std::string_view lowerDescription(uint32_t id) const;
+    int scoreName(std::string_view name, std::string_view query) const;
+    int scoreTypos(std::string_view name, size_t queryLength, int maxEdits, const uint64_t* peq) const;
+
+    std::vector<Doc> docs_;
+    std::string text_;
+    Postings names_;
+    Postings descriptions_;
+};
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * @file response_cache.cpp
+ * @brief On-disk ETag cache for conditional GitHub API requests
+ *
+ * Stores the ETag, Link header and body of each successful GET so the next
+ * request can send If-None-Match. GitHub answers unchanged resources with
+ * 304 Not Modified, which does not count against the rate limit.
+ */
+
+#include "response_cache.h"
+#include "config.h"
+#include "constants.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr const char* CACHE_MAGIC = "gh-repo-cache 1";
+}
+
+ResponseCache::ResponseCache(const std::string& dir, const std::string& token)
+    : dir_(dir), tokenKey_(sha256Hex(token)) {}
+
+/**
+ * @brief Maps a token and API path to a cache file name
+ */
+std::string ResponseCache::fileFor(const std::string& path) const {
+    return dir_ + "/" + sha256Hex(tokenKey_ + "\n" + path);
+}
+
+/**
+ * @brief Loads the cached response for a path
+ * @return Cached entry, or nullopt if missing or unreadable
+ */
+std::optional<CachedResponse> ResponseCache::load(const std::string& path) const {
+    std::ifstream file(fileFor(path), std::ios::binary);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    
+    std::string magic;
+    if (!std::getline(file, magic) || magic != CACHE_MAGIC) {
+        return std::nullopt;
+    }
+    
+    CachedResponse entry;
+    std::string line;
+    while (std::getline(file, line) && !line.empty()) {
+        if (line.compare(0, 5, "etag ") == 0) {
+            entry.etag = line.substr(5);
+        } else if (line.compare(0, 5, "link ") == 0) {
+            entry.link = line.substr(5);
+        }
+    }
+    if (entry.etag.empty()) {
+        return std::nullopt;
+    }
+    
+    std::ostringstream body;
+    body << file.rdbuf();
+    entry.body = body.str();
+    return entry;
+}
+
+/**
+ * @brief Writes a response to the cache
+ * @return true if the entry was written
+ *
+ * The file is written to a temporary name and renamed into place so that
+ * concurrent readers never see a partial entry. The first store prunes
+ * the directory, so the cache stays bounded across runs.
+ */
+bool ResponseCache::store(const std::string& path, const CachedResponse& entry) const {
+    if (entry.etag.empty() || entry.etag.find('\n') != std::string::npos ||
+        entry.link.find('\n') != std::string::npos) {
+        return false;
+    }
+    
+    std::call_once(pruneOnce_, [this]() {
+        prune(constants::CACHE_MAX_BYTES, std::chrono::seconds(constants::CACHE_MAX_AGE));
+    });
+    
+    std::error_code ec;
+    fs::create_directories(dir_, ec);
+    
+    std::string target = fileFor(path);
+    std::ostringstream tmpName;
+    tmpName << target << ".tmp." << getpid() << "." << std::this_thread::get_id();
+    {
+        std::ofstream file(tmpName.str(), std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file << CACHE_MAGIC << "\n";
+        file << "etag " << entry.etag << "\n";
+        if (!entry.link.empty()) {
+            file << "link " << entry.link << "\n";
+        }
+        file << "\n" << entry.body;
+        if (!file) {
+            fs::remove(tmpName.str(), ec);
+            return false;
+        }
+    }
+    fs::rename(tmpName.str(), target, ec);
+    if (ec) {
+        fs::remove(tmpName.str(), ec);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Removes every cached entry
+ */
+void ResponseCache::clear() const {
+    std::error_code ec;
+    fs::remove_all(dir_, ec);
+}
+
+/**
+ * @brief Bounds the cache directory, for every token
+ * @param maxBytes Total size kept; the least recently written entries go first
+ * @param maxAge Entries (and leftover temporary files) written longer ago are removed
+ * @return Number of files removed
+ */
+size_t ResponseCache::prune(size_t maxBytes, std::chrono::seconds maxAge) const {
+    struct Entry {
+        fs::path path;
+        fs::file_time_type writtenAt;
+        std::uintmax_t size;
+    };
+    std::vector<Entry> entries;
+    std::uintmax_t total = 0;
+    size_t removed = 0;
+    auto now = fs::file_time_type::clock::now();
+    
+    std::error_code ec;
+    for (fs::directory_iterator it(dir_, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code statError;
+        if (!it->is_regular_file(statError)) continue;
+        Entry entry{it->path(), it->last_write_time(statError), it->file_size(statError)};
+        if (statError) continue;
+        if (now - entry.writtenAt > maxAge) {
+            if (fs::remove(entry.path, statError)) removed++;
+            continue;
+        }
+        total += entry.size;
+        entries.push_back(std::move(entry));
+    }
+    
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.writtenAt < b.writtenAt;
+    });
+    for (const auto& entry : entries) {
+        if (total <= maxBytes) break;
+        std::error_code removeError;
+        if (fs::remove(entry.path, removeError)) removed++;
+        total -= entry.size;
+    }
+    return removed;
+}
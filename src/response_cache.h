@@ -0,0 +1,49 @@
+#ifndef RESPONSE_CACHE_H
+#define RESPONSE_CACHE_H
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <string>
+
+/**
+ * @brief Cached body and validator of a previous GET response
+ *
+ * The Link header is kept alongside the body because a 304 reply does not
+ * repeat it, and pagination depends on it.
+ */
+struct CachedResponse {
+    std::string etag;
+    std::string link;
+    std::string body;
+};
+
+/**
+ * @brief On-disk ETag cache for GitHub API GET requests
+ *
+ * Entries live under ~/.gh-repo-create/cache, one file per token and path, so
+ * different accounts never see each other's responses. The first store()
+ * of each instance prunes the directory to constants::CACHE_MAX_AGE and
+ * constants::CACHE_MAX_BYTES.
+ */
+class ResponseCache {
+public:
+    ResponseCache(const std::string& dir, const std::string& token);
+
+    std::optional<CachedResponse> load(const std::string& path) const;
+    bool store(const std::string& path, const CachedResponse& entry) const;
+    void clear() const;
+    size_t prune(size_t maxBytes, std::chrono::seconds maxAge) const;
+
+    const std::string& dir() const { return dir_; }
+
+private:
+    std::string fileFor(const std::string& path) const;
+
+    std::string dir_;
+    std::string tokenKey_;
+    mutable std::once_flag pruneOnce_;
+};
+
+#endif
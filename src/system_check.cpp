@@ -0,0 +1,280 @@
+/**
+ * @file system_check.cpp
+ * @brief Concurrent probes behind `--check` and the REPL `check` command
+ *
+ * The API, SSH and local git probes used to run one after another, so a
+ * slow or unreachable SSH endpoint held up the whole report. Each probe now
+ * runs on its own thread with its own deadline and prints its section the
+ * moment it is done.
+ */
+
+#include "system_check.h"
+#include "constants.h"
+#include "git_repo.h"
+#include "git_utils.h"
+#include "github.h"
+#include "output.h"
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const std::string RESET = "\033[0m";
+const std::string BOLD = "\033[1m";
+const std::string GREEN = "\033[32m";
+const std::string RED = "\033[31m";
+const std::string YELLOW = "\033[33m";
+const std::string GRAY = "\033[90m";
+
+enum class CheckStatus { Pass, Fail, Warn, Skip, Info, Hint };
+
+const char* statusName(CheckStatus status) {
+    switch (status) {
+        case CheckStatus::Pass: return "pass";
+        case CheckStatus::Fail: return "fail";
+        case CheckStatus::Warn: return "warn";
+        case CheckStatus::Skip: return "skip";
+        case CheckStatus::Info: return "info";
+        default:                return "hint";
+    }
+}
+
+/**
+ * @brief One report section: a heading and its status lines
+ */
+struct Section {
+    const char* probe;    // Name in --format output: api, ssh, git, permissions
+    const char* heading;
+    std::vector<std::pair<CheckStatus, std::string>> lines;
+
+    void add(CheckStatus status, std::string text) { lines.emplace_back(status, std::move(text)); }
+
+    std::string render() const {
+        std::string out;
+        for (const auto& [status, text] : lines) {
+            switch (status) {
+                case CheckStatus::Pass: out += GREEN + "   [PASS] " + RESET + text + "\n"; break;
+                case CheckStatus::Fail: out += RED + "   [FAIL] " + RESET + text + "\n"; break;
+                case CheckStatus::Warn: out += YELLOW + "   [WARN] " + RESET + text + "\n"; break;
+                case CheckStatus::Skip: out += YELLOW + "   [SKIP] " + RESET + text + "\n"; break;
+                case CheckStatus::Info: out += GRAY + "   " + text + "\n" + RESET; break;
+                case CheckStatus::Hint: out += GRAY + "   -> " + text + "\n" + RESET; break;
+            }
+        }
+        return out;
+    }
+};
+
+/**
+ * @brief Output of one probe; sections are printed together, in order
+ */
+struct ProbeResult {
+    std::vector<Section> sections;
+    bool passed = true;
+};
+
+/**
+ * @brief Token permissions, from the /user response the API probe already got
+ *
+ * The probe refreshes the identity, so these are the scopes GitHub reports
+ * now, not the ones kept in the identity cache by an earlier run.
+ */
+Section permissionsSection(GitHubClient& client, bool& passed) {
+    Section section{"permissions", "4. Token Permissions", {}};
+    auto scopes = client.tokenScopes();
+    if (!scopes) {
+        section.add(CheckStatus::Skip, "Not authenticated");
+    } else if (!scopes->reported) {
+        // Fine-grained and app tokens carry permissions, not scopes, and GitHub does not list them
+        section.add(CheckStatus::Skip, "Fine-grained token: GitHub does not report its permissions");
+        section.add(CheckStatus::Hint, "Needs repository Administration (read and write) and Metadata (read)");
+    } else {
+        auto join = [](const std::vector<std::string>& list) {
+            std::string joined;
+            for (const auto& scope : list) joined += (joined.empty() ? "" : ", ") + scope;
+            return joined;
+        };
+        std::string granted = scopes->granted.empty() ? "(none)" : join(scopes->granted);
+        section.add(CheckStatus::Info, "Scopes: " + granted);
+        if (!scopes->accepted.empty()) {
+            section.add(CheckStatus::Info, "Accepted by GET /user: " + join(scopes->accepted));
+        }
+
+        bool missing = false;
+        if (scopes->has("repo")) {
+            section.add(CheckStatus::Pass, "'repo': create and list public and private repositories");
+        } else if (scopes->has("public_repo")) {
+            section.add(CheckStatus::Warn, "Only 'public_repo': private repositories cannot be created or listed");
+        } else {
+            section.add(CheckStatus::Fail, "Missing 'repo' scope: create and list will fail");
+            missing = true;
+        }
+        if (scopes->has("delete_repo")) {
+            section.add(CheckStatus::Pass, "'delete_repo': delete repositories");
+        } else {
+            section.add(CheckStatus::Fail, "Missing 'delete_repo' scope: delete will fail");
+            missing = true;
+        }
+        if (missing) {
+            section.add(CheckStatus::Hint, "Edit the token's scopes at: https://github.com/settings/tokens");
+            passed = false;
+        }
+    }
+    return section;
+}
+
+ProbeResult apiProbe(GitHubClient* client, const std::string& noTokenHint) {
+    ProbeResult result;
+    Section section{"api", "1. GitHub API Access", {}};
+    if (!client) {
+        section.add(CheckStatus::Fail, "No GitHub token found");
+        section.add(CheckStatus::Hint, noTokenHint);
+        section.add(CheckStatus::Hint, "See: https://github.com/settings/tokens");
+        result.passed = false;
+        result.sections.push_back(std::move(section));
+        return result;
+    }
+
+    // Always ask GET /user: the identity cache would pass a token revoked since it was cached.
+    // One attempt within API_TIMEOUT, so a hung API cannot hold up the check or the client
+    int status = 0;
+    bool authenticated = client->probeIdentity(constants::API_TIMEOUT, status);
+    if (status == -1) {
+        section.add(CheckStatus::Fail, "No answer from the GitHub API within " +
+                                       std::to_string(constants::API_TIMEOUT) + " s");
+        section.add(CheckStatus::Hint, "Check your network connection and https://www.githubstatus.com");
+        result.passed = false;
+        result.sections.push_back(std::move(section));
+        return result;
+    }
+
+    if (authenticated) {
+        section.add(CheckStatus::Pass, "Authenticated as: " + client->getUsername());
+    } else {
+        section.add(CheckStatus::Fail, "Authentication failed - invalid token");
+        section.add(CheckStatus::Hint, "Your token may have expired or been revoked");
+        section.add(CheckStatus::Hint, "Generate a new token at: https://github.com/settings/tokens");
+        result.passed = false;
+    }
+    result.sections.push_back(std::move(section));
+    result.sections.push_back(permissionsSection(*client, result.passed));
+    return result;
+}
+
+ProbeResult sshProbe() {
+    ProbeResult result;
+    Section section{"ssh", "2. GitHub SSH Access", {}};
+    // BatchMode: a passphrase or host-key prompt would wait for the timeout
+    std::string timeout = std::to_string(constants::SSH_TIMEOUT);
+    auto ssh = GitUtils::runWithTimeout(
+        "ssh -T -o BatchMode=yes -o ConnectTimeout=" + timeout + " git@github.com", constants::SSH_TIMEOUT);
+
+    if (ssh.timedOut) {
+        section.add(CheckStatus::Fail, "No answer from git@github.com within " + timeout + " s");
+        section.add(CheckStatus::Hint, "Check that port 22 is reachable, or use ssh.github.com on port 443");
+        result.passed = false;
+    } else if (ssh.output.find("successfully authenticated") != std::string::npos) {
+        section.add(CheckStatus::Pass, "SSH access to GitHub working");
+    } else if (ssh.exitCode == -1 && ssh.output.empty()) {
+        section.add(CheckStatus::Fail, "Could not test SSH");
+        result.passed = false;
+    } else {
+        section.add(CheckStatus::Fail, "SSH access not configured");
+        section.add(CheckStatus::Hint, "Add SSH key to GitHub: Settings > SSH and GPG keys");
+        section.add(CheckStatus::Hint, "Run: ssh-add ~/.ssh/id_ed25519");
+        result.passed = false;
+    }
+    result.sections.push_back(std::move(section));
+    return result;
+}
+
+ProbeResult gitProbe(const std::string& path) {
+    ProbeResult result;
+    Section section{"git", "3. Local Git Repository", {}};
+    if (GitUtils::isGitRepo(path)) {
+        section.add(CheckStatus::Pass, path + " is a git repository");
+        if (!GitRepo::environmentOverrides()) {
+            auto repo = GitRepo::discover(path);
+            auto head = repo ? repo->head() : std::nullopt;
+            if (head) {
+                std::string commit = head->commit.substr(0, 7);
+                if (head->branch.empty()) {
+                    section.add(CheckStatus::Info, "HEAD detached at " + commit);
+                } else if (commit.empty()) {
+                    section.add(CheckStatus::Info, "On branch " + head->branch + ", no commits yet");
+                } else {
+                    section.add(CheckStatus::Info, "On branch " + head->branch + " at " + commit);
+                }
+            }
+        }
+
+        if (GitUtils::hasRemote(path, constants::DEFAULT_REMOTE)) {
+            auto remoteUrl = GitUtils::getRemoteUrl(path, constants::DEFAULT_REMOTE);
+            if (remoteUrl.has_value()) {
+                section.add(CheckStatus::Pass, "Origin remote: " + remoteUrl.value());
+            }
+        } else {
+            section.add(CheckStatus::Warn, "No 'origin' remote configured");
+        }
+    } else {
+        section.add(CheckStatus::Skip, path + " is not a git repository");
+    }
+    result.sections.push_back(std::move(section));
+    return result;
+}
+
+}  // namespace
+
+bool runSystemCheck(GitHubClient* client, const std::string& path, const std::string& noTokenHint,
+                    OutputWriter* writer) {
+    std::mutex outputMutex;
+    auto start = std::chrono::steady_clock::now();
+
+    // Prints a probe's sections as soon as it finishes, with the time it took
+    auto run = [&](std::function<ProbeResult()> probe) {
+        return std::async(std::launch::async, [&outputMutex, start, writer, probe = std::move(probe)]() {
+            ProbeResult result = probe();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            std::lock_guard<std::mutex> lock(outputMutex);
+            if (writer) {
+                for (const auto& section : result.sections) {
+                    for (const auto& [status, text] : section.lines) {
+                        writer->beginRecord();
+                        writer->field("probe", section.probe);
+                        writer->field("status", statusName(status));
+                        writer->field("message", text);
+                        writer->field("seconds", seconds);
+                        writer->endRecord();
+                    }
+                }
+                writer->flush();
+                return result.passed;
+            }
+
+            char elapsed[32];
+            std::snprintf(elapsed, sizeof(elapsed), "%.1f s", seconds);
+            for (const auto& section : result.sections) {
+                std::cout << BOLD << section.heading << RESET << GRAY << "  (" << elapsed << ")" << RESET << "\n"
+                          << section.render() << "\n";
+            }
+            std::cout.flush();
+            return result.passed;
+        });
+    };
+
+    auto api = run([client, &noTokenHint]() { return apiProbe(client, noTokenHint); });
+    auto ssh = run([]() { return sshProbe(); });
+    auto git = run([&path]() { return gitProbe(path); });
+
+    bool passed = api.get();
+    passed = ssh.get() && passed;
+    passed = git.get() && passed;
+    return passed;
+}
@@ -0,0 +1,28 @@
+#ifndef SYSTEM_CHECK_H
+#define SYSTEM_CHECK_H
+
+#include <string>
+
+class GitHubClient;
+class OutputWriter;
+
+/**
+ * @brief Runs the probes of `--check` and the REPL `check` command
+ *
+ * The GitHub API (with token permissions), SSH and local git probes run
+ * concurrently and each prints its section as soon as it finishes, so the
+ * check takes as long as the slowest probe. The API probe makes one
+ * GET /user attempt and gives up after constants::API_TIMEOUT seconds and the SSH probe after
+ * constants::SSH_TIMEOUT.
+ *
+ * @param client Client for the configured token, or nullptr if there is none
+ * @param path Local repository to inspect
+ * @param noTokenHint Where to add a token, printed when client is nullptr
+ * @param writer If set, each line is written as a record (probe, status,
+ *        message, seconds) instead of the colored report
+ * @return true if no probe failed
+ */
+bool runSystemCheck(GitHubClient* client, const std::string& path, const std::string& noTokenHint,
+                    OutputWriter* writer = nullptr);
+
+#endif
@@ -0,0 +1,140 @@
+/**
+ * @file trace.cpp
+ * @brief Span recording and Chrome trace-event export
+ */
+
+#include "trace.h"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <fstream>
+
+namespace {
+
+std::atomic<bool> traceEnabled{false};
+
+double micros(Trace::Clock::duration d) {
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+}  // namespace
+
+// ============================================================================
+// Span
+// ============================================================================
+
+Trace::Span::Span(const std::string& name, const char* category) {
+    if (!Trace::enabled()) return;
+    event_.emplace();
+    event_->name = name;
+    event_->category = category;
+    event_->start = Clock::now();
+}
+
+void Trace::Span::set(const std::string& key, double value) {
+    if (event_) event_->numbers.emplace_back(key, value);
+}
+
+void Trace::Span::set(const std::string& key, const std::string& value) {
+    if (event_) event_->strings.emplace_back(key, value);
+}
+
+void Trace::Span::end() {
+    if (!event_) return;
+    event_->end = Clock::now();
+    Trace::instance().record(std::move(*event_));
+    event_.reset();
+}
+
+// ============================================================================
+// Trace
+// ============================================================================
+
+Trace& Trace::instance() {
+    static Trace trace;
+    return trace;
+}
+
+bool Trace::enabled() {
+    return traceEnabled.load(std::memory_order_relaxed);
+}
+
+void Trace::enable() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        origin_ = Clock::now();
+        threadNumber(std::this_thread::get_id());
+    }
+    traceEnabled = true;
+}
+
+void Trace::record(Event event) {
+    if (!enabled()) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    event.thread = threadNumber(std::this_thread::get_id());
+    events_.push_back(std::move(event));
+}
+
+/**
+ * @brief Small, stable thread numbers in order of first appearance; 1 is main
+ */
+uint32_t Trace::threadNumber(std::thread::id id) {
+    auto it = threads_.find(id);
+    if (it != threads_.end()) return it->second;
+    uint32_t number = static_cast<uint32_t>(threads_.size()) + 1;
+    threads_.emplace(id, number);
+    return number;
+}
+
+size_t Trace::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_.size();
+}
+
+std::vector<Trace::Event> Trace::events() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_;
+}
+
+/**
+ * @brief Renders the recorded spans in the Chrome trace-event format
+ *
+ * Spans are complete ("X") events with microsecond timestamps relative to
+ * enable(). Phases of one request are recorded as shorter spans on the same
+ * thread, so trace viewers nest them under the request.
+ */
+std::string Trace::toJson() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    nlohmann::json events = nlohmann::json::array();
+    events.push_back({{"name", "process_name"}, {"ph", "M"}, {"pid", 1},
+                      {"args", {{"name", "gh-repo"}}}});
+    for (const auto& [id, number] : threads_) {
+        events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", number},
+                          {"args", {{"name", number == 1 ? "main" : "thread " + std::to_string(number)}}}});
+    }
+
+    for (const auto& event : events_) {
+        nlohmann::json args = nlohmann::json::object();
+        for (const auto& [key, value] : event.numbers) args[key] = value;
+        for (const auto& [key, value] : event.strings) args[key] = value;
+        events.push_back({
+            {"name", event.name},
+            {"cat", event.category},
+            {"ph", "X"},
+            {"ts", micros(event.start - origin_)},
+            {"dur", micros(event.end - event.start)},
+            {"pid", 1},
+            {"tid", event.thread},
+            {"args", std::move(args)}
+        });
+    }
+
+    nlohmann::json trace = {{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}};
+    return trace.dump();
+}
+
+bool Trace::write(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file << toJson();
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,84 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Process-wide recorder of timed spans, exported as Chrome trace JSON
+ *
+ * Disabled by default, in which case recording is a single atomic load.
+ * When enabled (--trace), HTTP requests and git/ssh subprocesses record
+ * their phases here; write() produces a file that chrome://tracing or
+ * https://ui.perfetto.dev can open.
+ */
+class Trace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief One completed span ("X" event): name, category, interval, arguments
+     */
+    struct Event {
+        std::string name;
+        std::string category;
+        Clock::time_point start;
+        Clock::time_point end;
+        std::vector<std::pair<std::string, double>> numbers;
+        std::vector<std::pair<std::string, std::string>> strings;
+        uint32_t thread = 0;  // Filled in by record()
+    };
+
+    /**
+     * @brief Records the time from construction to destruction (or end())
+     *
+     * Does nothing, and allocates nothing, while tracing is disabled.
+     */
+    class Span {
+    public:
+        Span(const std::string& name, const char* category);
+        ~Span() { end(); }
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+        void set(const std::string& key, double value);
+        void set(const std::string& key, const std::string& value);
+        void end();
+
+    private:
+        std::optional<Event> event_;
+    };
+
+    static Trace& instance();
+    static bool enabled();
+
+    /**
+     * @brief Starts recording; timestamps are relative to this call
+     */
+    void enable();
+    void record(Event event);
+
+    size_t size() const;
+    std::vector<Event> events() const;
+    std::string toJson() const;
+    bool write(const std::string& path) const;
+
+private:
+    Trace() = default;
+    uint32_t threadNumber(std::thread::id id);
+
+    mutable std::mutex mutex_;
+    Clock::time_point origin_;
+    std::vector<Event> events_;
+    std::unordered_map<std::thread::id, uint32_t> threads_;
+};
+
+#endif
@@ -0,0 +1,48 @@
+/**
+ * @file transport.cpp
+ * @brief Transport selection and shared response helpers
+ */
+
+#include "transport.h"
+#include <strings.h>
+
+std::string_view HttpResponse::header(std::string_view name) const {
+    for (const auto& [key, value] : headers) {
+        if (key.size() == name.size() && strncasecmp(key.data(), name.data(), key.size()) == 0) {
+            return value;
+        }
+    }
+    return {};
+}
+
+std::optional<TransportKind> parseTransportKind(const std::string& name) {
+    if (name == "httplib") return TransportKind::Httplib;
+    if (name == "curl") return TransportKind::Curl;
+    return std::nullopt;
+}
+
+const char* transportKindName(TransportKind kind) {
+    return kind == TransportKind::Curl ? "curl" : "httplib";
+}
+
+std::vector<TransportKind> availableTransports() {
+#ifdef GH_REPO_HAVE_CURL
+    return {TransportKind::Httplib, TransportKind::Curl};
+#else
+    return {TransportKind::Httplib};
+#endif
+}
+
+std::unique_ptr<Transport> makeTransport(TransportKind kind, const TransportConfig& config) {
+    switch (kind) {
+        case TransportKind::Httplib:
+            return makeHttplibTransport(config);
+        case TransportKind::Curl:
+#ifdef GH_REPO_HAVE_CURL
+            return makeCurlTransport(config);
+#else
+            return nullptr;
+#endif
+    }
+    return nullptr;
+}
@@ -0,0 +1,102 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using HttpHeaders = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief One API request, relative to the transport's base URL
+ */
+struct HttpRequest {
+    std::string method;  // GET, POST, PATCH or DELETE
+    std::string path;
+    HttpHeaders headers;
+    std::string body;
+    std::string contentType = "application/json";
+    int timeout = 0;     // Seconds for this exchange if set, instead of TransportConfig::timeout
+};
+
+/**
+ * @brief Response, or failure, of one request
+ *
+ * Time points are left unset when the backend cannot observe that phase.
+ */
+struct HttpResponse {
+    using Clock = std::chrono::steady_clock;
+
+    int status = -1;         // -1 when no response was received
+    std::string error;       // Transport error message when status is -1
+    std::string body;        // Decoded (decompressed) body
+    HttpHeaders headers;
+    bool reused = false;     // Sent on an already-open connection
+    std::string httpVersion; // "1.1", "2", ... when known
+
+    Clock::time_point sentAt;       // Handed to the network layer
+    Clock::time_point connectedAt;  // TCP connected (new connections only)
+    Clock::time_point handshakeAt;  // TLS handshake done (new connections only)
+    Clock::time_point headersAt;    // Response headers received
+
+    /**
+     * @brief Case-insensitive lookup of the first header with this name
+     * @return View into headers, or an empty view if there is none
+     */
+    std::string_view header(std::string_view name) const;
+};
+
+/**
+ * @brief Settings shared by every transport backend
+ */
+struct TransportConfig {
+    std::string baseUrl;          // Scheme, host and optional port
+    HttpHeaders defaultHeaders;   // Sent with every request
+    size_t maxConnections = 4;
+    int timeout = 60;             // Seconds allowed for connecting, and for the whole exchange
+};
+
+/**
+ * @brief HTTP backend used by GitHubClient
+ *
+ * send() blocks until the response is complete and may be called from many
+ * threads at once; backends bound their own connection use.
+ */
+class Transport {
+public:
+    virtual ~Transport() = default;
+
+    virtual HttpResponse send(const HttpRequest& request) = 0;
+    virtual const char* name() const = 0;
+    virtual void setDebug(bool) {}
+};
+
+enum class TransportKind {
+    Httplib,  // Blocking cpp-httplib clients from a keep-alive pool (default)
+    Curl      // libcurl multi event loop, HTTP/2 multiplexed where available
+};
+
+std::optional<TransportKind> parseTransportKind(const std::string& name);
+const char* transportKindName(TransportKind kind);
+
+/**
+ * @brief Backends compiled into this build, default first
+ */
+std::vector<TransportKind> availableTransports();
+
+/**
+ * @brief Creates a backend, or nullptr if it was not compiled in
+ */
+std::unique_ptr<Transport> makeTransport(TransportKind kind, const TransportConfig& config);
+
+std::unique_ptr<Transport> makeHttplibTransport(const TransportConfig& config);
+#ifdef GH_REPO_HAVE_CURL
+std::unique_ptr<Transport> makeCurlTransport(const TransportConfig& config);
+#endif
+
+#endif
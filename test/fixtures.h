@@ -0,0 +1,113 @@
+#ifndef TEST_FIXTURES_H
+#define TEST_FIXTURES_H
+
+#include <sstream>
+#include <string>
+
+namespace fixtures {
+
+/**
+ * @brief Builds one repository object shaped like the GitHub REST API's
+ *
+ * Includes the nested owner, permissions and license objects and the long
+ * tail of *_url fields, so pages have the size and structure of real ones.
+ * The name defaults to "repo-<id>".
+ */
+inline std::string repoJson(const std::string& owner, int id, bool isPrivate = false,
+                            const std::string& repoName = "") {
+    std::string name = repoName.empty() ? "repo-" + std::to_string(id) : repoName;
+    std::string full = owner + "/" + name;
+    std::string api = "https://api.github.com/repos/" + full;
+    std::ostringstream o;
+    o << "{\"id\":" << (100000 + id) << ",\"node_id\":\"R_kgDO" << id << "\",\"name\":\"" << name
+      << "\",\"full_name\":\"" << full << "\",\"private\":" << (isPrivate ? "true" : "false")
+      << ",\"owner\":{\"login\":\"" << owner << "\",\"id\":4242,\"node_id\":\"U_kgDO4242\","
+      << "\"avatar_url\":\"https://avatars.githubusercontent.com/u/4242?v=4\",\"gravatar_id\":\"\","
+      << "\"url\":\"https://api.github.com/users/" << owner << "\","
+      << "\"html_url\":\"https://github.com/" << owner << "\","
+      << "\"followers_url\":\"https://api.github.com/users/" << owner << "/followers\","
+      << "\"following_url\":\"https://api.github.com/users/" << owner << "/following{/other_user}\","
+      << "\"gists_url\":\"https://api.github.com/users/" << owner << "/gists{/gist_id}\","
+      << "\"starred_url\":\"https://api.github.com/users/" << owner << "/starred{/owner}{/repo}\","
+      << "\"subscriptions_url\":\"https://api.github.com/users/" << owner << "/subscriptions\","
+      << "\"organizations_url\":\"https://api.github.com/users/" << owner << "/orgs\","
+      << "\"repos_url\":\"https://api.github.com/users/" << owner << "/repos\","
+      << "\"events_url\":\"https://api.github.com/users/" << owner << "/events{/privacy}\","
+      << "\"received_events_url\":\"https://api.github.com/users/" << owner << "/received_events\","
+      << "\"type\":\"User\",\"site_admin\":false},"
+      << "\"html_url\":\"https://github.com/" << full << "\","
+      << "\"description\":" << (id % 3 == 0 ? std::string("null") : "\"Synthetic repository number " + std::to_string(id) + "\"") << ","
+      << "\"fork\":false,\"url\":\"" << api << "\",";
+    const char* urlFields[] = {
+        "forks", "keys", "collaborators", "teams", "hooks", "issue_events", "events", "assignees",
+        "branches", "tags", "blobs", "git_tags", "git_refs", "trees", "statuses", "languages",
+        "stargazers", "contributors", "subscribers", "subscription", "commits", "git_commits",
+        "comments", "issue_comment", "contents", "compare", "merges", "archive", "downloads",
+        "issues", "pulls", "milestones", "notifications", "labels", "releases", "deployments"
+    };
+    for (const char* field : urlFields) {
+        o << "\"" << field << "_url\":\"" << api << "/" << field << "{/id}\",";
+    }
+    o << "\"created_at\":\"2024-01-01T00:00:00Z\","
+      << "\"updated_at\":\"2026-01-" << (10 + id % 18) << "T12:00:00Z\","
+      << "\"pushed_at\":\"2026-01-01T00:00:00Z\","
+      << "\"git_url\":\"git://github.com/" << full << ".git\","
+      << "\"ssh_url\":\"git@github.com:" << full << ".git\","
+      << "\"clone_url\":\"https://github.com/" << full << ".git\","
+      << "\"svn_url\":\"https://github.com/" << full << "\",\"homepage\":null,"
+      << "\"size\":" << (id * 7 % 5000) << ",\"stargazers_count\":" << (id % 50)
+      << ",\"watchers_count\":" << (id % 50) << ",\"language\":\"C++\","
+      << "\"has_issues\":true,\"has_projects\":true,\"has_downloads\":true,\"has_wiki\":true,"
+      << "\"has_pages\":false,\"has_discussions\":false,\"forks_count\":0,\"mirror_url\":null,"
+      << "\"archived\":false,\"disabled\":false,\"open_issues_count\":0,"
+      << "\"license\":{\"key\":\"mit\",\"name\":\"MIT License\",\"spdx_id\":\"MIT\","
+      << "\"url\":\"https://api.github.com/licenses/mit\",\"node_id\":\"MDc6TGljZW5zZTEz\"},"
+      << "\"allow_forking\":true,\"is_template\":false,\"web_commit_signoff_required\":false,"
+      << "\"topics\":[\"cli\",\"github\"],\"visibility\":\"" << (isPrivate ? "private" : "public") << "\","
+      << "\"forks\":0,\"open_issues\":0,\"watchers\":" << (id % 50) << ",\"default_branch\":\"main\","
+      << "\"permissions\":{\"admin\":true,\"maintain\":true,\"push\":true,\"triage\":true,\"pull\":true}}";
+    return o.str();
+}
+
+/**
+ * @brief Builds a JSON array page of repositories first .. first + count - 1
+ */
+inline std::string repoPageJson(const std::string& owner, int first, int count) {
+    std::string page = "[";
+    for (int i = 0; i < count; i++) {
+        if (i > 0) page += ",";
+        page += repoJson(owner, first + i, (first + i) % 4 == 0);
+    }
+    page += "]";
+    return page;
+}
+
+/**
+ * @brief Builds a GraphQL viewer.repositories page for the same repositories
+ *
+ * Node fields match what GitHubClient selects, so the page has the size of
+ * a real projected response.
+ */
+inline std::string graphqlPageJson(const std::string& owner, int first, int count, bool hasNextPage) {
+    std::ostringstream o;
+    o << "{\"data\":{\"viewer\":{\"repositories\":{\"pageInfo\":{\"hasNextPage\":"
+      << (hasNextPage ? "true" : "false") << ",\"endCursor\":\"Y3Vyc29yOnYyOpHO" << (first + count - 1)
+      << "\"},\"nodes\":[";
+    for (int i = 0; i < count; i++) {
+        int id = first + i;
+        std::string full = owner + "/repo-" + std::to_string(id);
+        if (i > 0) o << ",";
+        o << "{\"name\":\"repo-" << id << "\",\"description\":"
+          << (id % 3 == 0 ? std::string("null") : "\"Synthetic repository number " + std::to_string(id) + "\"")
+          << ",\"isPrivate\":" << (id % 4 == 0 ? "true" : "false")
+          << ",\"url\":\"https://github.com/" << full << "\""
+          << ",\"sshUrl\":\"git@github.com:" << full << ".git\""
+          << ",\"updatedAt\":\"2026-01-" << (10 + id % 18) << "T12:00:00Z\"}";
+    }
+    o << "]}}}}";
+    return o.str();
+}
+
+}  // namespace fixtures
+
+#endif
@@ -1,11 +1,37 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest/doctest.h"
 #include "github.h"
+#include "git_repo.h"
 #include "git_utils.h"
 #include "config.h"
+#include "fixtures.h"
+#include "identity_cache.h"
+#include "connection_pool.h"
+#include "executor.h"
+#include "metrics.h"
+#include "mock_server.h"
+#include "output.h"
+#include "repo_index.h"
+#include "repo_list.h"
+#include "repo_parser.h"
+#include "repo_search.h"
+#include "rate_limiter.h"
+#include "reconcile.h"
+#include "response_cache.h"
+#include "trace.h"
+#include "transport.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <future>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
 #include <cstdio>
+#include <cstdlib>
 
 namespace fs = std::filesystem;
 
@@ -74,6 +100,70 @@ TEST_CASE("GitUtils - getCurrentBranch on non-git directory") {
     fs::remove_all("/tmp/test-branch-not-git");
 }
 
+TEST_CASE("GitRepo - reads HEAD, refs and remotes without running git") {
+    fs::path root = fs::temp_directory_path() / "gh-repo-test-gitrepo";
+    fs::path git = root / ".git";
+    fs::remove_all(root);
+    fs::create_directories(git / "objects");
+    fs::create_directories(git / "refs" / "heads");
+    fs::create_directories(root / "src" / "deep");
+    auto write = [](const fs::path& path, const std::string& text) { std::ofstream(path) << text; };
+    
+    std::string packed(40, 'a');
+    std::string config = "[core]\n\tbare = false\n[remote \"origin\"]\n"
+                         "\turl = https://github.com/octocat/tool.git ; comment\n";
+    write(git / "HEAD", "ref: refs/heads/main\n");
+    write(git / "packed-refs", "# pack-refs with: peeled fully-peeled sorted\n" + packed + " refs/heads/main\n");
+    write(git / "config", config);
+    write(root / "global", "[url \"git@github.com:\"]\n\tinsteadOf = https://github.com/\n");
+    setenv("GIT_CONFIG_GLOBAL", (root / "global").c_str(), 1);
+    setenv("GIT_CONFIG_NOSYSTEM", "1", 1);
+    
+    auto repo = GitRepo::discover((root / "src" / "deep").string());
+    REQUIRE(repo.has_value());
+    auto head = repo->head();
+    REQUIRE(head.has_value());
+    CHECK(head->branch == "main");
+    CHECK(head->commit == packed);
+    CHECK(repo->hasRemote("origin"));
+    CHECK(!repo->hasRemote("upstream"));
+    CHECK(repo->remoteUrl("origin") == std::optional<std::string>("git@github.com:octocat/tool.git"));
+    CHECK(repo->configValue("Core.Bare") == std::optional<std::string>("false"));
+    CHECK(GitUtils::getCurrentBranch(root.string()) == std::optional<std::string>("main"));
+    
+    // A loose ref wins over packed-refs; a detached HEAD is reported as "HEAD"
+    std::string loose(40, 'b');
+    write(git / "refs" / "heads" / "main", loose + "\n");
+    CHECK(repo->head()->commit == loose);
+    write(git / "HEAD", loose + "\n");
+    CHECK(GitUtils::getCurrentBranch(root.string()) == std::optional<std::string>("HEAD"));
+    
+    // includeIf files may not apply, so remotes they set make the answer git's to give
+    write(root / "work", "[remote \"origin\"]\n\turl = elsewhere\n");
+    write(git / "config", config + "[includeIf \"gitdir:/nowhere/\"]\n\tpath = ../work\n");
+    auto conditional = GitRepo::discover(root.string());
+    REQUIRE(conditional.has_value());
+    CHECK(!conditional->configComplete("remote."));
+    CHECK(conditional->configComplete("user."));
+    
+    unsetenv("GIT_CONFIG_GLOBAL");
+    unsetenv("GIT_CONFIG_NOSYSTEM");
+    fs::remove_all(root);
+}
+
+TEST_CASE("GitUtils - runWithTimeout captures output and kills overruns") {
+    auto done = GitUtils::runWithTimeout("echo out; echo err >&2; exit 3", 5);
+    CHECK(done.timedOut == false);
+    CHECK(done.exitCode == 3);
+    CHECK(done.output == "out\nerr\n");
+    
+    auto start = std::chrono::steady_clock::now();
+    auto slow = GitUtils::runWithTimeout("sleep 30", 1);
+    CHECK(slow.timedOut == true);
+    CHECK(slow.exitCode == -1);
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(5));
+}
+
 TEST_CASE("ConfigManager - default construction") {
     ConfigManager config;
 }
@@ -152,6 +242,14 @@ TEST_CASE("GitHubClient - repositoryExists with valid token") {
     CHECK(client.repositoryExists("nonexistent-repo") == false);
 }
 
+TEST_CASE("GitHubClient - repositoriesExist answers every name") {
+    GitHubClient client("invalid-token");
+    auto result = client.repositoriesExist({"first-missing", "second-missing"});
+    CHECK(result.size() == 2);
+    CHECK(result["first-missing"] == false);
+    CHECK(result["second-missing"] == false);
+}
+
 TEST_CASE("GitHubClient - deleteRepository with invalid token returns false") {
     GitHubClient client("invalid-token");
     CHECK(client.deleteRepository("nonexistent-repo") == false);
@@ -189,3 +287,959 @@ TEST_CASE("GitHubClient - authenticate with empty token returns false") {
     GitHubClient client("");
     CHECK(client.authenticate() == false);
 }
+
+TEST_CASE("GitHubClient - async calls from several threads on one client") {
+    GitHubClient client("invalid-token");
+    std::vector<std::future<bool>> results;
+    std::vector<std::thread> callers;
+    std::mutex resultsMutex;
+    for (int i = 0; i < 4; i++) {
+        callers.emplace_back([&, i]() {
+            auto exists = client.repositoryExistsAsync("missing-" + std::to_string(i));
+            std::lock_guard<std::mutex> lock(resultsMutex);
+            results.push_back(std::move(exists));
+        });
+    }
+    for (auto& caller : callers) caller.join();
+    
+    auto repos = client.listRepositoriesAsync();
+    auto auth = client.authenticateAsync();
+    for (auto& result : results) {
+        CHECK(result.get() == false);
+    }
+    CHECK(repos.get().empty());
+    CHECK(auth.get() == false);
+}
+
+TEST_CASE("GitHubClient - lists every page from the API stand-in, GraphQL and REST") {
+    for (TransportKind kind : availableTransports()) {
+        SUBCASE(transportKindName(kind)) {
+            mock::GitHubServer server({250});
+            GitHubClient client(server.token(), server.baseUrl());
+            REQUIRE(client.setTransport(kind));
+            client.setCacheEnabled(false);
+            REQUIRE(client.authenticate());
+            CHECK(client.getUsername() == "octocat");
+            
+            auto viaGraphQL = client.listRepositories();
+            client.setGraphQLEnabled(false);
+            auto viaRest = client.listRepositories();
+            REQUIRE(viaGraphQL.size() == 250);
+            REQUIRE(viaRest.size() == 250);
+            for (size_t i = 0; i < viaRest.size(); i++) {
+                CHECK(viaGraphQL[i].name == viaRest[i].name);
+                CHECK(viaGraphQL[i].description == viaRest[i].description);
+                CHECK(viaGraphQL[i].isPrivate == viaRest[i].isPrivate);
+                CHECK(viaGraphQL[i].sshUrl == viaRest[i].sshUrl);
+                CHECK(viaGraphQL[i].updatedAt == viaRest[i].updatedAt);
+            }
+            CHECK(viaRest.back().name == "repo-250");
+        }
+    }
+}
+
+TEST_CASE("GitHubClient - GraphQL and REST list the same repositories across owners") {
+    mock::Options options;
+    options.repoCount = 3;
+    options.shared = {{"acme", "zebra"}, {"zeta-corp", "alpha"}, {"acme", "repo-2"}};
+    options.ordered = true;
+    mock::GitHubServer server(options);
+    GitHubClient client(server.token(), server.baseUrl());
+    client.setCacheEnabled(false);
+    REQUIRE(client.authenticate());
+    
+    auto viaGraphQL = client.listRepositories();
+    client.setGraphQLEnabled(false);
+    auto viaRest = client.listRepositories();
+    REQUIRE(viaGraphQL.size() == 6);
+    REQUIRE(viaRest.size() == 6);
+    
+    // REST sorts by owner/name, GraphQL by name alone
+    CHECK(viaRest.front().htmlUrl == "https://github.com/acme/repo-2");
+    CHECK(viaRest.back().htmlUrl == "https://github.com/zeta-corp/alpha");
+    CHECK(viaGraphQL.front().htmlUrl == "https://github.com/zeta-corp/alpha");
+    CHECK(viaGraphQL.back().htmlUrl == "https://github.com/acme/zebra");
+    
+    auto byUrl = [](const RepoInfo& a, const RepoInfo& b) { return a.htmlUrl < b.htmlUrl; };
+    std::sort(viaGraphQL.begin(), viaGraphQL.end(), byUrl);
+    std::sort(viaRest.begin(), viaRest.end(), byUrl);
+    for (size_t i = 0; i < viaRest.size(); i++) {
+        CHECK(viaGraphQL[i].htmlUrl == viaRest[i].htmlUrl);
+        CHECK(viaGraphQL[i].sshUrl == viaRest[i].sshUrl);
+        CHECK(viaGraphQL[i].description == viaRest[i].description);
+        CHECK(viaGraphQL[i].isPrivate == viaRest[i].isPrivate);
+        CHECK(viaGraphQL[i].updatedAt == viaRest[i].updatedAt);
+    }
+}
+
+TEST_CASE("GitHubClient - lists several organizations into one owner-tagged list") {
+    mock::Options options;
+    options.orgs = {{"acme", 250}, {"globex", 3}, {"initech", 0}};
+    mock::GitHubServer server(options);
+    GitHubClient client(server.token(), server.baseUrl());
+    client.setCacheEnabled(false);
+
+    auto orgs = client.listOrganizations();
+    std::vector<std::string> expected = {"acme", "globex", "initech"};
+    CHECK(orgs == expected);
+
+    RepoList repos = client.listOrganizationRepositories(orgs);
+    REQUIRE(repos.size() == 253);
+    CHECK(repos.owner(0) == "acme");
+    CHECK(repos.name(249) == "repo-250");
+    CHECK(repos.owner(250) == "globex");
+    CHECK(repos.htmlUrl(252) == "https://github.com/globex/repo-3");
+
+    // An organization that cannot be listed does not take the others down
+    RepoList partial = client.listOrganizationRepositories({"missing-org", "globex"});
+    CHECK(partial.size() == 3);
+}
+
+TEST_CASE("GitHubClient - hands listing pages to the callback as they are added") {
+    mock::GitHubServer server({250});
+    GitHubClient client(server.token(), server.baseUrl());
+    client.setCacheEnabled(false);
+    
+    for (bool graphql : {true, false}) {
+        client.setGraphQLEnabled(graphql);
+        std::vector<size_t> starts;
+        size_t seen = 0;
+        RepoList repos = client.listRepositoriesCompact([&](const RepoList& list, size_t from) {
+            starts.push_back(from);
+            seen = list.size();
+        });
+        REQUIRE(repos.size() == 250);
+        std::vector<size_t> expected = {0, 100, 200};
+        CHECK(starts == expected);
+        CHECK(seen == 250);
+    }
+}
+
+TEST_CASE("GitHubClient - create, check and delete against the API stand-in") {
+    for (TransportKind kind : availableTransports()) {
+        SUBCASE(transportKindName(kind)) {
+            mock::GitHubServer server({3});
+            GitHubClient client(server.token(), server.baseUrl());
+            REQUIRE(client.setTransport(kind));
+            client.setCacheEnabled(false);
+            client.setMutationInterval(std::chrono::milliseconds(0));
+            REQUIRE(client.authenticate());
+            
+            RepoInfo repo;
+            repo.name = "brand-new";
+            CHECK(client.createRepository(repo) == true);
+            CHECK(client.createRepository(repo) == false);
+            CHECK(server.repoCount() == 4);
+            CHECK(client.repositoryExists("repo-2") == true);
+            CHECK(client.repositoryExists("brand-new") == true);
+            
+            CHECK(client.updateRepository("brand-new", std::string("Described"), true) == true);
+            CHECK(client.deleteRepository("brand-new") == true);
+            CHECK(client.deleteRepository("brand-new") == false);
+            CHECK(client.repositoryExists("brand-new") == false);
+            CHECK(server.repoCount() == 3);
+            
+            GitHubClient wrongToken("other-token", server.baseUrl());
+            REQUIRE(wrongToken.setTransport(kind));
+            CHECK(wrongToken.authenticate() == false);
+        }
+    }
+}
+
+TEST_CASE("Transport - concurrent requests on every backend") {
+    for (TransportKind kind : availableTransports()) {
+        SUBCASE(transportKindName(kind)) {
+            mock::Options options;
+            options.repoCount = 50;
+            options.latency = std::chrono::milliseconds(20);
+            mock::GitHubServer server(options);
+            
+            TransportConfig config;
+            config.baseUrl = server.baseUrl();
+            config.defaultHeaders = {{"Authorization", "Bearer " + server.token()}};
+            auto transport = makeTransport(kind, config);
+            REQUIRE(transport);
+            
+            std::vector<std::future<HttpResponse>> responses;
+            for (int i = 1; i <= 20; i++) {
+                responses.push_back(std::async(std::launch::async, [&transport, i]() {
+                    return transport->send({"GET", "/repos/octocat/repo-" + std::to_string(i), {}, ""});
+                }));
+            }
+            for (auto& response : responses) {
+                HttpResponse r = response.get();
+                CHECK(r.status == 200);
+                CHECK(r.header("content-type") == "application/json");
+                CHECK(r.body.find("\"name\":\"repo-") != std::string::npos);
+            }
+            
+            HttpResponse created = transport->send({"POST", "/user/repos", {}, R"({"name":"via-transport"})"});
+            CHECK(created.status == 201);
+            CHECK(transport->send({"DELETE", "/repos/octocat/via-transport", {}, ""}).status == 204);
+            
+            TransportConfig closed = config;
+            closed.baseUrl = "http://127.0.0.1:1";
+            HttpResponse failed = makeTransport(kind, closed)->send({"GET", "/user", {}, ""});
+            CHECK(failed.status == -1);
+            CHECK(!failed.error.empty());
+        }
+    }
+}
+
+TEST_CASE("GitHubClient - retries transient failures from the API stand-in") {
+    mock::Options options;
+    options.repoCount = 120;
+    options.failFirst = 2;
+    mock::GitHubServer server(options);
+    GitHubClient client(server.token(), server.baseUrl());
+    client.setCacheEnabled(false);
+    
+    CHECK(client.listRepositories().size() == 120);
+    CHECK(server.injectedErrors() == 2);
+}
+
+TEST_CASE("GitHubClient - probeIdentity gives up after its timeout without retrying") {
+    mock::Options options;
+    options.latency = std::chrono::milliseconds(3000);
+    mock::GitHubServer server(options);
+    GitHubClient client(server.token(), server.baseUrl());
+
+    int status = 0;
+    auto start = std::chrono::steady_clock::now();
+    CHECK(client.probeIdentity(1, status) == false);
+    CHECK(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(2500));
+    CHECK(status == -1);
+    CHECK(server.requests() == 1);
+}
+
+TEST_CASE("Trace - records request phases as Chrome trace events") {
+    mock::GitHubServer server({3});
+    GitHubClient client(server.token(), server.baseUrl());
+    client.setCacheEnabled(false);
+    Trace::instance().enable();
+    
+    {
+        Trace::Span span("probe", "test");
+        span.set("answer", 42);
+        REQUIRE(client.authenticate());
+        CHECK(client.deleteRepository("repo-1") == true);
+    }
+    
+    auto events = Trace::instance().events();
+    auto has = [&](const std::string& name, const std::string& category) {
+        return std::any_of(events.begin(), events.end(), [&](const Trace::Event& e) {
+            return e.name == name && e.category == category && e.end >= e.start;
+        });
+    };
+    CHECK(has("probe", "test"));
+    CHECK(has("GET /user", "http"));
+    CHECK(has("DELETE /repos/octocat/repo-1", "http"));
+    CHECK(has("ttfb", "http.phase"));
+    CHECK(has("transfer", "http.phase"));
+    CHECK(has("exchange", "http.phase"));
+    
+    auto trace = nlohmann::json::parse(Trace::instance().toJson());
+    REQUIRE(trace["traceEvents"].is_array());
+    bool found = false;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event.value("name", "") == "probe") {
+            found = true;
+            CHECK(event["ph"] == "X");
+            CHECK(event["args"]["answer"] == 42);
+            CHECK(event["dur"].get<double>() >= 0);
+        }
+    }
+    CHECK(found);
+}
+
+TEST_CASE("Metrics - groups endpoints and renders OpenMetrics") {
+    CHECK(Metrics::endpoint("/user/repos?per_page=100&page=3") == "/user/repos");
+    CHECK(Metrics::endpoint("/repos/octocat/hello-world") == "/repos/{owner}/{repo}");
+    CHECK(Metrics::endpoint("/repos/octocat/hello-world/topics") == "/repos/{owner}/{repo}/topics");
+    CHECK(Metrics::endpoint("/orgs/acme/repos") == "/orgs/{org}/repos");
+    
+    Metrics metrics;
+    metrics.recordRequest("GET", "/user/repos?page=1", 200, 0.02, 1000, 0, false);
+    metrics.recordRequest("GET", "/user/repos?page=2", 503, 0.3, 20, 0, false);
+    metrics.recordRequest("GET", "/user/repos?page=2", 200, 0.07, 900, 0, true);
+    metrics.recordRequest("DELETE", "/repos/octocat/a", 204, 0.2, 0, 0, false);
+    metrics.recordCacheLookup(true);
+    metrics.recordCacheLookup(false);
+    metrics.recordSubprocess("git push", 1.5);
+    CHECK(metrics.requests() == 4);
+    CHECK(metrics.retries() == 1);
+    CHECK(metrics.cacheHits() == 1);
+    CHECK(metrics.subprocesses() == 1);
+    
+    std::string text = metrics.toOpenMetrics();
+    CHECK(text.find("gh_repo_api_requests_total{endpoint=\"/user/repos\",method=\"GET\",status=\"200\"} 2\n") != std::string::npos);
+    CHECK(text.find("gh_repo_api_request_duration_seconds_bucket{endpoint=\"/user/repos\",le=\"0.05\"} 1\n") != std::string::npos);
+    CHECK(text.find("gh_repo_api_request_duration_seconds_bucket{endpoint=\"/user/repos\",le=\"+Inf\"} 3\n") != std::string::npos);
+    CHECK(text.find("gh_repo_api_retries_total{endpoint=\"/user/repos\"} 1\n") != std::string::npos);
+    CHECK(text.find("gh_repo_api_bytes_total{endpoint=\"/user/repos\",direction=\"in\"} 1920\n") != std::string::npos);
+    CHECK(text.find("gh_repo_api_cache_lookups_total{result=\"miss\"} 1\n") != std::string::npos);
+    CHECK(text.find("gh_repo_subprocesses_total{command=\"git push\"} 1\n") != std::string::npos);
+    CHECK(text.size() >= 6);
+    CHECK(text.substr(text.size() - 6) == "# EOF\n");
+    CHECK(metrics.summary().find("/repos/{owner}/{repo}") != std::string::npos);
+}
+
+TEST_CASE("Metrics - the client counts requests against the API stand-in") {
+    mock::GitHubServer server({3});
+    GitHubClient client(server.token(), server.baseUrl());
+    client.setCacheEnabled(false);
+    auto before = Metrics::instance().requests();
+    REQUIRE(client.authenticate());
+    CHECK(client.repositoryExists("repo-2") == true);
+    CHECK(Metrics::instance().requests() - before == server.requests());
+    CHECK(Metrics::instance().toOpenMetrics().find("endpoint=\"/repos/{owner}/{repo}\",method=\"GET\",status=\"200\"") != std::string::npos);
+}
+
+TEST_CASE("Executor - runs tasks concurrently and returns their results") {
+    Executor executor(4);
+    CHECK(executor.threads() == 4);
+    
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 16; i++) {
+        futures.push_back(executor.submit([&, i]() {
+            int now = ++running;
+            int seen = peak.load();
+            while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            --running;
+            return i * i;
+        }));
+    }
+    for (int i = 0; i < 16; i++) {
+        CHECK(futures[i].get() == i * i);
+    }
+    CHECK(peak.load() > 1);
+    CHECK(peak.load() <= 4);
+    
+    auto failing = executor.submit([]() -> int { throw std::runtime_error("boom"); });
+    CHECK_THROWS_AS(failing.get(), std::runtime_error);
+}
+
+TEST_CASE("ConnectionPool - released clients are handed out again") {
+    ConnectionPool pool("https://api.github.com", 2);
+    void* first = nullptr;
+    {
+        auto lease = pool.acquire();
+        first = &lease.client();
+        CHECK(lease.reused() == false);
+    }
+    auto again = pool.acquire();
+    CHECK(&again.client() == first);
+    
+    auto second = pool.acquire();
+    CHECK(&second.client() != first);
+}
+
+TEST_CASE("parseLinkHeader - extracts next and last paths") {
+    std::string link = "<https://api.github.com/user/repos?per_page=100&page=2>; rel=\"next\", "
+                       "<https://api.github.com/user/repos?per_page=100&page=41>; rel=\"last\"";
+    CHECK(parseLinkHeader(link, "next") == "/user/repos?per_page=100&page=2");
+    CHECK(parseLinkHeader(link, "last") == "/user/repos?per_page=100&page=41");
+    CHECK(parseLinkHeader(link, "prev").empty());
+    CHECK(parseLinkHeader("", "next").empty());
+}
+
+TEST_CASE("ApiResponse - reads headers in place, ignoring case") {
+    HttpResponse raw;
+    raw.status = 200;
+    raw.body = R"([{"name":"hello-world","private":false}])";
+    raw.headers = {{"link", "<https://api.github.com/user/repos?page=2>; rel=\"next\""},
+                   {"X-OAuth-Scopes", ""}};
+    const char* body = raw.body.data();
+
+    ApiResponse res(std::move(raw));
+    CHECK(res.status() == 200);
+    CHECK(res.body().data() == body);  // Moved, not copied
+    CHECK(parseLinkHeader(res.header("Link"), "next") == "/user/repos?page=2");
+    CHECK(res.header("x-oauth-scopes").empty());
+    CHECK(res.header("x-oauth-scopes").data() != nullptr);
+    CHECK(res.header("ETag").data() == nullptr);
+}
+
+TEST_CASE("pageNumber and withPageNumber ignore per_page") {
+    std::string path = "/user/repos?per_page=100&page=41";
+    CHECK(pageNumber(path) == 41);
+    CHECK(pageNumber("/user/repos?per_page=100") == 0);
+    CHECK(withPageNumber(path, 7) == "/user/repos?per_page=100&page=7");
+    CHECK(withPageNumber("/user/repos?page=3&per_page=100", 9) == "/user/repos?page=9&per_page=100");
+    CHECK(withPageNumber("/user/repos?per_page=100", 2) == "/user/repos?per_page=100&page=2");
+}
+
+TEST_CASE("ResponseCache - store and load round trip") {
+    std::string dir = "/tmp/test-response-cache";
+    fs::remove_all(dir);
+    ResponseCache cache(dir, "token-a");
+    
+    CHECK(cache.load("/user/repos").has_value() == false);
+    
+    CachedResponse entry{"W/\"abc123\"", "<https://api.github.com/user/repos?page=2>; rel=\"next\"", "[{\"name\":\"x\"}]\n"};
+    CHECK(cache.store("/user/repos", entry) == true);
+    
+    auto loaded = cache.load("/user/repos");
+    REQUIRE(loaded.has_value());
+    CHECK(loaded->etag == entry.etag);
+    CHECK(loaded->link == entry.link);
+    CHECK(loaded->body == entry.body);
+    
+    ResponseCache otherToken(dir, "token-b");
+    CHECK(otherToken.load("/user/repos").has_value() == false);
+    
+    fs::remove_all(dir);
+}
+
+TEST_CASE("ResponseCache - prune drops old entries, then the oldest over the size limit") {
+    std::string dir = "/tmp/test-response-cache-prune";
+    fs::remove_all(dir);
+    ResponseCache cache(dir, "token-a");
+    CachedResponse entry{"\"e\"", "", std::string(1000, 'x')};
+    
+    // Entry files are named by hash: backdate each one as it appears
+    std::vector<std::pair<std::string, std::chrono::hours>> ages = {
+        {"/older", std::chrono::hours(24 * 60)}, {"/old", std::chrono::hours(3)},
+        {"/newer", std::chrono::hours(2)}, {"/newest", std::chrono::hours(1)}};
+    std::set<fs::path> seen;
+    for (const auto& [path, age] : ages) {
+        REQUIRE(cache.store(path, entry));
+        for (const auto& file : fs::directory_iterator(dir)) {
+            if (seen.insert(file.path()).second) {
+                fs::last_write_time(file.path(), fs::file_time_type::clock::now() - age);
+            }
+        }
+    }
+    
+    CHECK(cache.prune(2500, std::chrono::hours(24 * 30)) == 2);
+    CHECK(cache.load("/older").has_value() == false);
+    CHECK(cache.load("/old").has_value() == false);
+    CHECK(cache.load("/newer").has_value());
+    CHECK(cache.load("/newest").has_value());
+    
+    fs::remove_all(dir);
+}
+
+TEST_CASE("IdentityCache - fresh entries only, for the same token") {
+    std::string dir = "/tmp/test-identity-cache";
+    fs::remove_all(dir);
+    IdentityCache cache(dir, "token-a");
+    std::time_t now = 1800000000;
+    
+    CHECK(cache.load(now).has_value() == false);
+    CHECK(cache.store({"octocat", "repo, delete_repo", "", now}) == true);
+    
+    auto loaded = cache.load(now + 60);
+    REQUIRE(loaded.has_value());
+    CHECK(loaded->login == "octocat");
+    CHECK(loaded->scopes == "repo, delete_repo");
+    CHECK(cache.load(now + constants::IDENTITY_CACHE_TTL).has_value() == false);
+    CHECK(IdentityCache(dir, "token-b").load(now).has_value() == false);
+    
+    // Never trusted past the token's own expiry
+    CHECK(parseTokenExpiration("2027-01-15 09:00:00 UTC") == std::optional<std::time_t>(now + 3600));
+    CHECK(parseTokenExpiration("2027-01-15 11:00:00 +0200") == std::optional<std::time_t>(now + 3600));
+    CHECK(parseTokenExpiration("never").has_value() == false);
+    CHECK(cache.store({"octocat", "repo", "2027-01-15 09:00:00 UTC", now}) == true);
+    CHECK(cache.load(now + 60).has_value() == true);
+    CHECK(cache.load(now + 3600).has_value() == false);
+    
+    cache.invalidate();
+    CHECK(cache.load(now).has_value() == false);
+    fs::remove_all(dir);
+}
+
+TEST_CASE("GitHubClient - cached identity skips GET /user until a 401") {
+    mock::Options options;
+    options.token = "identity-cache-test-token";
+    mock::GitHubServer server(options);
+    std::string dir = "/tmp/test-client-identity";
+    fs::remove_all(dir);
+    IdentityCache cache(dir, server.token());
+    
+    {
+        GitHubClient client(server.token(), server.baseUrl());
+        client.setDataDir(dir);
+        REQUIRE(client.authenticate());
+        CHECK(server.requests() == 1);
+        REQUIRE(cache.load().has_value());
+        CHECK(cache.load()->scopes == "repo, delete_repo");
+    }
+    {
+        GitHubClient client(server.token(), server.baseUrl());
+        client.setDataDir(dir);
+        CHECK(client.authenticate() == true);
+        CHECK(client.getUsername() == "octocat");
+        CHECK(server.requests() == 1);
+        CHECK(client.authenticate(true) == true);
+        CHECK(server.requests() == 2);
+    }
+    
+    // A refresh, as --check does, notices the revoked token despite the cache
+    mock::GitHubServer revoked;
+    {
+        GitHubClient client(server.token(), revoked.baseUrl());
+        client.setDataDir(dir);
+        CHECK(client.authenticate(true) == false);
+        CHECK(client.tokenScopes().has_value() == false);
+        CHECK(cache.load().has_value() == false);
+    }
+    {
+        GitHubClient client(server.token(), server.baseUrl());
+        client.setDataDir(dir);
+        REQUIRE(client.authenticate());
+        REQUIRE(cache.load().has_value());
+    }
+    
+    // Same token against a server that rejects it: the entry is dropped
+    GitHubClient client(server.token(), revoked.baseUrl());
+    client.setDataDir(dir);
+    client.setMutationInterval(std::chrono::milliseconds(0));
+    CHECK(client.authenticate() == true);
+    CHECK(client.deleteRepository("anything") == false);
+    CHECK(cache.load().has_value() == false);
+    CHECK(client.authenticate() == false);
+    fs::remove_all(dir);
+}
+
+TEST_CASE("GitHubClient - a refresh reports the token's current scopes, not the cached ones") {
+    std::string dir = "/tmp/test-client-scopes";
+    fs::remove_all(dir);
+    mock::Options options;
+    options.token = "scope-refresh-test-token";
+    {
+        mock::GitHubServer server(options);
+        GitHubClient client(server.token(), server.baseUrl());
+        client.setDataDir(dir);
+        REQUIRE(client.authenticate());
+        CHECK(client.tokenScopes()->has("delete_repo"));
+    }
+    
+    // Same token after delete_repo was taken away
+    options.scopes = "repo";
+    mock::GitHubServer server(options);
+    {
+        GitHubClient client(server.token(), server.baseUrl());
+        client.setDataDir(dir);
+        REQUIRE(client.authenticate());
+        CHECK(client.tokenScopes()->has("delete_repo"));
+        CHECK(server.requests() == 0);
+    }
+    GitHubClient client(server.token(), server.baseUrl());
+    client.setDataDir(dir);
+    REQUIRE(client.authenticate(true));
+    CHECK(server.requests() == 1);
+    REQUIRE(client.tokenScopes().has_value());
+    CHECK(client.tokenScopes()->has("repo"));
+    CHECK(client.tokenScopes()->has("delete_repo") == false);
+    CHECK(IdentityCache(dir, server.token()).load()->scopes == "repo");
+    fs::remove_all(dir);
+}
+
+TEST_CASE("TokenScopes - read from the /user response without extra requests") {
+    std::vector<std::string> expected = {"repo", "delete_repo", "read:org"};
+    CHECK(parseScopeList(" repo,delete_repo , read:org") == expected);
+    CHECK(parseScopeList("").empty());
+    
+    TokenScopes scopes;
+    scopes.granted = {"repo", "admin:org"};
+    CHECK(scopes.has("repo"));
+    CHECK(scopes.has("public_repo"));
+    CHECK(scopes.has("read:org"));
+    CHECK_FALSE(scopes.has("delete_repo"));
+    
+    mock::Options options;
+    options.scopes = "public_repo";
+    mock::GitHubServer server(options);
+    GitHubClient client(server.token(), server.baseUrl());
+    client.setCacheEnabled(false);
+    CHECK(client.tokenScopes().has_value() == false);
+    REQUIRE(client.authenticate());
+    
+    auto granted = client.tokenScopes();
+    REQUIRE(granted.has_value());
+    CHECK(granted->reported);
+    CHECK(granted->has("public_repo"));
+    CHECK_FALSE(granted->has("repo"));
+    CHECK_FALSE(granted->has("delete_repo"));
+    CHECK(server.requests() == 1);
+}
+
+TEST_CASE("RepoIndex - replace, lookup and incremental merge") {
+    std::string path = "/tmp/test-repo-index/index.bin";
+    fs::remove_all("/tmp/test-repo-index");
+    
+    RepoIndex index(path);
+    CHECK(index.load() == false);
+    CHECK(index.size() == 0);
+    
+    std::vector<RepoInfo> repos(2);
+    repos[0].name = "zeta";
+    repos[0].isPrivate = true;
+    repos[0].htmlUrl = "https://github.com/user/zeta";
+    repos[0].updatedAt = "2026-01-02T00:00:00Z";
+    repos[1].name = "Alpha";
+    repos[1].description = "first";
+    repos[1].htmlUrl = "https://github.com/user/Alpha";
+    repos[1].updatedAt = "2026-01-01T00:00:00Z";
+    REQUIRE(index.replace(repos, 1000));
+    
+    CHECK(index.size() == 2);
+    CHECK(index.at(0).name == "Alpha");
+    CHECK(index.at(0).owner == "user");
+    CHECK(index.at(0).description == "first");
+    CHECK(index.at(1).isPrivate == true);
+    CHECK(index.find("User", "alpha").has_value());
+    CHECK(index.find("user", "missing").has_value() == false);
+    CHECK(index.find("acme", "alpha").has_value() == false);
+    CHECK(index.newestUpdatedAt() == "2026-01-02T00:00:00Z");
+    CHECK(index.fullSyncTime() == 1000);
+    
+    RepoInfo beta;
+    beta.name = "beta";
+    beta.htmlUrl = "https://github.com/user/beta";
+    beta.updatedAt = "2026-01-03T00:00:00Z";
+    REQUIRE(index.merge({beta}, {{"user", "zeta"}}));
+    CHECK(index.size() == 2);
+    CHECK(index.find("user", "beta").has_value());
+    CHECK(index.find("user", "zeta").has_value() == false);
+    CHECK(index.fullSyncTime() == 1000);
+    
+    RepoIndex reopened(path);
+    CHECK(reopened.load() == true);
+    CHECK(reopened.size() == 2);
+    CHECK(reopened.newestUpdatedAt() == "2026-01-03T00:00:00Z");
+    
+    fs::remove_all("/tmp/test-repo-index");
+}
+
+TEST_CASE("RepoIndex - keeps the same name under different owners apart") {
+    std::string path = "/tmp/test-repo-index-owners/index.bin";
+    fs::remove_all("/tmp/test-repo-index-owners");
+    
+    RepoIndex index(path);
+    std::vector<RepoInfo> repos = {
+        {"repo-2", "mine", false, "https://github.com/octocat/repo-2", "git@github.com:octocat/repo-2.git", "2026-01-01T00:00:00Z"},
+        {"repo-2", "theirs", true, "https://github.com/acme/repo-2", "git@github.com:acme/repo-2.git", "2026-01-02T00:00:00Z"},
+        {"Repo-2", "mine again", false, "https://github.com/octocat/Repo-2", "git@github.com:octocat/Repo-2.git", "2026-01-03T00:00:00Z"}
+    };
+    REQUIRE(index.replace(repos, 1000));
+    REQUIRE(index.size() == 2);
+    CHECK(index.at(0).owner == "acme");
+    CHECK(index.at(*index.find("octocat", "repo-2")).description == "mine again");
+    CHECK(index.at(*index.find("acme", "repo-2")).description == "theirs");
+    
+    // Deleting the user's repository leaves the organization's alone
+    REQUIRE(index.merge({}, {{"octocat", "repo-2"}}));
+    CHECK(index.size() == 1);
+    CHECK(index.find("acme", "repo-2").has_value());
+    
+    fs::remove_all("/tmp/test-repo-index-owners");
+}
+
+TEST_CASE("RepoList - packs repositories and derives their URLs") {
+    std::vector<RepoInfo> repos = {
+        {"Alpha", "First", false, "https://github.com/octocat/Alpha", "git@github.com:octocat/Alpha.git", "2026-01-01T00:00:00Z"},
+        {"beta-tool", "", true, "https://github.com/octo-org/beta-tool", "git@github.com:octo-org/beta-tool.git", "2026-02-01T00:00:00Z"},
+        {"odd", "Mirror", false, "https://example.com/mirrors/odd/", "", "2026-03-01T00:00:00Z"}
+    };
+    RepoList list;
+    list.append(repos);
+    REQUIRE(list.size() == 3);
+    CHECK(list.name(1) == "beta-tool");
+    CHECK(list.description(0) == "First");
+    CHECK(list.isPrivate(1) == true);
+    CHECK(list.updatedAt(2) == "2026-03-01T00:00:00Z");
+    for (size_t i = 0; i < repos.size(); i++) {
+        CHECK(list.htmlUrl(i) == repos[i].htmlUrl);
+        CHECK(list.sshUrl(i) == repos[i].sshUrl);
+    }
+    
+    RepoList page;
+    page.add({"gamma", "Third", false, "https://github.com/octo-org/gamma", "git@github.com:octo-org/gamma.git", ""});
+    list.append(page);
+    CHECK(list.size() == 4);
+    CHECK(list.sshUrl(3) == "git@github.com:octo-org/gamma.git");
+    
+    list.truncate(2);
+    CHECK(list.size() == 2);
+    CHECK(list.toVector()[1].htmlUrl == repos[1].htmlUrl);
+}
+
+TEST_CASE("RepoSearch - ranks exact, prefix, typo and description matches") {
+    RepoList list;
+    for (const char* name : {"payments-api", "old-payments", "payments", "Dotfiles", "billing"}) {
+        std::string description = std::string(name) == "billing" ? "Invoices and payments" : "";
+        list.add({name, description, false, std::string("https://github.com/octo-org/") + name,
+                  std::string("git@github.com:octo-org/") + name + ".git", ""});
+    }
+    RepoSearch search;
+    search.build(list);
+    REQUIRE(search.size() == 5);
+    CHECK(search.name(3) == "Dotfiles");
+    
+    auto hits = search.search("Payments");
+    std::vector<uint32_t> ids;
+    for (const auto& hit : hits) ids.push_back(hit.id);
+    std::vector<uint32_t> expected = {2, 0, 1, 4};
+    CHECK(ids == expected);
+    CHECK(hits[0].score == RepoSearch::EXACT);
+    CHECK(hits[3].score == RepoSearch::DESCRIPTION);
+    
+    auto typo = search.search("paymnts");
+    REQUIRE(!typo.empty());
+    CHECK(search.name(typo[0].id) == "payments");
+    CHECK(search.search("dotfles", 1).size() == 1);
+    CHECK(search.search("zzzzzz").empty());
+    CHECK(search.search("").size() == 5);
+    CHECK(search.search("pay", 2).size() == 2);
+}
+
+TEST_CASE("OutputWriter - json, ndjson and tsv records with escaping") {
+    RepoList list;
+    list.add({"tool", "Tabs\tand \"quotes\"\n", true, "https://github.com/octocat/tool",
+              "git@github.com:octocat/tool.git", "2026-01-01T00:00:00Z"});
+    list.add({"lib", "", false, "https://github.com/octocat/lib", "git@github.com:octocat/lib.git", ""});
+    
+    auto render = [&](OutputFormat format, size_t count) {
+        std::ostringstream out;
+        OutputWriter writer(format, out);
+        for (size_t i = 0; i < count; i++) {
+            writer.repo(list, i);
+        }
+        writer.finish();
+        return out.str();
+    };
+    
+    std::string ndjson = render(OutputFormat::Ndjson, 2);
+    std::string firstLine = ndjson.substr(0, ndjson.find('\n'));
+    auto record = nlohmann::json::parse(firstLine);
+    CHECK(record["owner"] == "octocat");
+    CHECK(record["private"] == true);
+    CHECK(record["description"] == "Tabs\tand \"quotes\"\n");
+    CHECK(std::count(ndjson.begin(), ndjson.end(), '\n') == 2);
+    
+    auto array = nlohmann::json::parse(render(OutputFormat::Json, 2));
+    REQUIRE(array.size() == 2);
+    CHECK(array[1]["name"] == "lib");
+    CHECK(render(OutputFormat::Json, 0) == "[]\n");
+    
+    std::string tsv = render(OutputFormat::Tsv, 1);
+    CHECK(tsv == "owner\tname\tprivate\tdescription\thtml_url\tssh_url\tupdated_at\n"
+                 "octocat\ttool\ttrue\tTabs\\tand \"quotes\"\\n\thttps://github.com/octocat/tool\t"
+                 "git@github.com:octocat/tool.git\t2026-01-01T00:00:00Z\n");
+    
+    CHECK(parseOutputFormat("ndjson") == OutputFormat::Ndjson);
+    CHECK(!parseOutputFormat("yaml").has_value());
+}
+
+TEST_CASE("parseRepoPage - streaming decoder matches DOM decoder") {
+    std::string page = fixtures::repoPageJson("octocat", 1, 20);
+    std::vector<RepoInfo> streamed, dom;
+    REQUIRE(parseRepoPage(page, streamed));
+    REQUIRE(parseRepoPageDom(page, dom));
+    REQUIRE(streamed.size() == dom.size());
+    for (size_t i = 0; i < dom.size(); i++) {
+        CHECK(streamed[i].name == dom[i].name);
+        CHECK(streamed[i].description == dom[i].description);
+        CHECK(streamed[i].isPrivate == dom[i].isPrivate);
+        CHECK(streamed[i].htmlUrl == dom[i].htmlUrl);
+        CHECK(streamed[i].sshUrl == dom[i].sshUrl);
+        CHECK(streamed[i].updatedAt == dom[i].updatedAt);
+    }
+    CHECK(streamed[0].sshUrl == "git@github.com:octocat/repo-1.git");
+}
+
+TEST_CASE("parseRepoPage - rejects non-arrays and truncated pages") {
+    std::vector<RepoInfo> repos;
+    std::string error;
+    CHECK(parseRepoPage("{\"message\":\"Bad credentials\"}", repos, &error) == false);
+    CHECK(error == "response is not an array");
+    CHECK(parseRepoPage("[{\"name\":\"a\"},{\"name\":", repos) == false);
+    CHECK(repos.empty());
+    
+    RepoInfo repo;
+    CHECK(parseRepoObject(fixtures::repoJson("octocat", 4, true), repo) == true);
+    CHECK(repo.name == "repo-4");
+    CHECK(repo.isPrivate == true);
+}
+
+TEST_CASE("parseGraphQLRepoPage - matches the REST decoder and reads the cursor") {
+    std::vector<RepoInfo> rest, graphql;
+    GraphQLPageInfo page;
+    REQUIRE(parseRepoPage(fixtures::repoPageJson("octocat", 1, 20), rest));
+    REQUIRE(parseGraphQLRepoPage(fixtures::graphqlPageJson("octocat", 1, 20, true), graphql, page));
+    REQUIRE(graphql.size() == rest.size());
+    for (size_t i = 0; i < rest.size(); i++) {
+        CHECK(graphql[i].name == rest[i].name);
+        CHECK(graphql[i].description == rest[i].description);
+        CHECK(graphql[i].isPrivate == rest[i].isPrivate);
+        CHECK(graphql[i].htmlUrl == rest[i].htmlUrl);
+        CHECK(graphql[i].sshUrl == rest[i].sshUrl);
+        CHECK(graphql[i].updatedAt == rest[i].updatedAt);
+    }
+    CHECK(page.hasNextPage == true);
+    CHECK(page.endCursor == "Y3Vyc29yOnYyOpHO20");
+    
+    REQUIRE(parseGraphQLRepoPage(fixtures::graphqlPageJson("octocat", 21, 0, false), graphql, page));
+    CHECK(graphql.size() == rest.size());
+    CHECK(page.hasNextPage == false);
+}
+
+TEST_CASE("parseGraphQLRepoPage - reports GraphQL errors") {
+    std::vector<RepoInfo> repos;
+    GraphQLPageInfo page;
+    std::string error;
+    CHECK(parseGraphQLRepoPage(R"({"data":null,"errors":[{"type":"FORBIDDEN","message":"Resource not accessible"}]})",
+                               repos, page, &error) == false);
+    CHECK(error == "Resource not accessible");
+    CHECK(parseGraphQLRepoPage(R"({"message":"Bad credentials"})", repos, page, &error) == false);
+    CHECK(parseGraphQLRepoPage("[]", repos, page, &error) == false);
+    CHECK(parseGraphQLRepoPage(R"({"data":{"viewer":{"repositories":{"nodes":[{"name":"a"},)", repos, page) == false);
+    CHECK(repos.empty());
+}
+
+TEST_CASE("RateLimiter - tracks budget and adapts concurrency") {
+    RateLimiter limiter(4, 8);
+    CHECK(limiter.status().remaining == -1);
+    CHECK(limiter.status().concurrency == 4);
+    
+    RateLimitHeaders ok{"5000", "4999", "1700000000", ""};
+    {
+        auto permit = limiter.acquire(false);
+        CHECK(limiter.status().inFlight == 1);
+    }
+    CHECK(limiter.status().inFlight == 0);
+    CHECK(limiter.record(200, ok, "", true, 0).has_value() == false);
+    CHECK(limiter.status().limit == 5000);
+    CHECK(limiter.status().remaining == 4999);
+    
+    RateLimitHeaders throttled{"5000", "4998", "1700000000", "1"};
+    auto retry = limiter.record(429, throttled, "", true, 0);
+    REQUIRE(retry.has_value());
+    CHECK(retry->count() >= 1000);
+    CHECK(retry->count() <= 2000);
+    CHECK(limiter.status().concurrency == 2);
+    CHECK(limiter.status().pausedFor.count() > 0);
+    
+    CHECK(limiter.record(-1, {}, "", false, 0).has_value() == false);
+    CHECK(limiter.record(-1, {}, "", true, 0).has_value() == true);
+    CHECK(limiter.record(403, {}, "Resource not accessible", true, 0).has_value() == false);
+    
+    RateLimitHeaders graphql{"5000", "12", "1700000000", "", "graphql"};
+    limiter.record(200, graphql, "", true, 0);
+    CHECK(limiter.status().remaining == 4998);
+}
+
+TEST_CASE("parseManifest - accepts names and objects, rejects bad entries") {
+    std::vector<ManifestEntry> entries;
+    std::string error;
+    REQUIRE(parseManifest(R"({"repositories": [
+        "plain",
+        {"name": "lib", "description": "Shared code", "visibility": "private"},
+        {"name": "old-service", "state": "absent"}
+    ]})", entries, error));
+    REQUIRE(entries.size() == 3);
+    CHECK(entries[0].name == "plain");
+    CHECK_FALSE(entries[0].description.has_value());
+    CHECK_FALSE(entries[0].isPrivate.has_value());
+    CHECK(entries[1].description == std::optional<std::string>("Shared code"));
+    CHECK(entries[1].isPrivate == std::optional<bool>(true));
+    CHECK(entries[2].present == false);
+    
+    CHECK(parseManifest(R"(["a", "b"])", entries, error));
+    CHECK(entries.size() == 2);
+    
+    CHECK_FALSE(parseManifest(R"(["dup", "DUP"])", entries, error));
+    CHECK_FALSE(parseManifest(R"([{"name": "bad name"}])", entries, error));
+    CHECK_FALSE(parseManifest(R"([{"name": "x", "visibility": "internal"}])", entries, error));
+    CHECK_FALSE(parseManifest(R"([{"name": "x", "state": "gone"}])", entries, error));
+    CHECK_FALSE(parseManifest(R"({"repos": []})", entries, error));
+    CHECK_FALSE(parseManifest("not json", entries, error));
+    CHECK(entries.size() == 2);
+}
+
+TEST_CASE("applyReconcile - plans against the user's own repositories only") {
+    std::string dir = "/tmp/test-apply-owners";
+    fs::remove_all(dir);
+    mock::Options options;
+    options.repoCount = 2;
+    options.shared = {{"acme", "repo-2"}, {"acme", "theirs"}};
+    mock::GitHubServer server(options);
+    GitHubClient client(server.token(), server.baseUrl());
+    client.setDataDir(dir);
+    client.setCacheEnabled(false);
+    client.setMutationInterval(std::chrono::milliseconds(0));
+    REQUIRE(client.authenticate());
+    REQUIRE(client.syncIndex(true));
+    CHECK(client.repoIndex().size() == 4);
+    
+    auto own = ownRepositories(client.repoIndex(), client.getUsername());
+    REQUIRE(own.size() == 2);
+    
+    // repo-2 matches the user's own repository, not acme's (which has no description)
+    std::vector<ManifestEntry> manifest;
+    std::string error;
+    REQUIRE(parseManifest(R"({"repositories": [
+        {"name": "repo-2", "description": "Synthetic repository number 2"},
+        "theirs",
+        {"name": "repo-1", "state": "absent"}
+    ]})", manifest, error));
+    auto actions = planReconcile(manifest, own);
+    REQUIRE(actions.size() == 2);
+    CHECK(actions[0].kind == ReconcileAction::Kind::Create);
+    CHECK(actions[0].name == "theirs");
+    CHECK(actions[1].kind == ReconcileAction::Kind::Delete);
+    CHECK(actions[1].name == "repo-1");
+    
+    for (const auto& result : applyReconcile(client, actions, 2)) {
+        CHECK(result.ok);
+    }
+    CHECK(server.repoCount() == 2);
+    CHECK(client.repoIndex().find("octocat", "theirs").has_value());
+    CHECK(client.repoIndex().find("acme", "theirs").has_value());
+    CHECK(client.repoIndex().find("octocat", "repo-1").has_value() == false);
+    fs::remove_all(dir);
+}
+
+TEST_CASE("planReconcile - emits only the calls that change something") {
+    std::vector<RepoInfo> current(3);
+    current[0].name = "Keep";
+    current[0].description = "same";
+    current[1].name = "flip";
+    current[1].isPrivate = false;
+    current[2].name = "retire";
+    
+    std::vector<ManifestEntry> desired(5);
+    desired[0].name = "keep";
+    desired[0].description = "same";
+    desired[0].isPrivate = false;
+    desired[1].name = "flip";
+    desired[1].isPrivate = true;
+    desired[2].name = "retire";
+    desired[2].present = false;
+    desired[3].name = "already-gone";
+    desired[3].present = false;
+    desired[4].name = "new-one";
+    
+    auto actions = planReconcile(desired, current);
+    REQUIRE(actions.size() == 3);
+    
+    CHECK(actions[0].kind == ReconcileAction::Kind::Update);
+    CHECK(actions[0].name == "flip");
+    CHECK(actions[0].isPrivate == std::optional<bool>(true));
+    CHECK_FALSE(actions[0].description.has_value());
+    
+    CHECK(actions[1].kind == ReconcileAction::Kind::Delete);
+    CHECK(actions[1].name == "retire");
+    
+    CHECK(actions[2].kind == ReconcileAction::Kind::Create);
+    CHECK(actions[2].name == "new-one");
+    CHECK(actions[2].isPrivate == std::optional<bool>(false));
+    CHECK(describeAction(actions[2]) == "create new-one (public)");
+    
+    CHECK(planReconcile(desired, {}).size() == 3);
+}
@@ -0,0 +1,384 @@
+#ifndef TEST_MOCK_SERVER_H
+#define TEST_MOCK_SERVER_H
+
+#include "fixtures.h"
+#include <httplib.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace mock {
+
+/**
+ * @brief Behaviour of the stand-in server
+ */
+struct Options {
+    size_t repoCount = 0;                   // Repositories "repo-1" .. "repo-N" to start with
+    std::string login = "octocat";
+    std::string token = "mock-token";       // Other tokens get 401
+    std::string scopes = "repo, delete_repo";  // X-OAuth-Scopes of GET /user
+    std::chrono::milliseconds latency{0};   // Added to every response
+    std::chrono::milliseconds jitter{0};    // Uniform extra latency in [0, jitter]
+    double errorRate = 0.0;                 // Fraction of requests answered with errorStatus
+    size_t failFirst = 0;                   // The first N requests get errorStatus
+    int errorStatus = 503;
+    bool graphql = true;                    // Serve POST /graphql
+    std::vector<std::pair<std::string, size_t>> orgs;  // Organizations of the user and their repository counts
+    std::vector<std::pair<std::string, std::string>> shared;  // Other owners' repositories the user can access: (owner, name)
+    bool ordered = false;                   // Sort listings like GitHub: /user/repos by full name, GraphQL by name
+    size_t threads = 32;
+};
+
+/**
+ * @brief Local HTTP stand-in for the parts of the GitHub API the client uses
+ *
+ * Serves GET /user, /rate_limit, /user/repos and /orgs/{org}/repos (with
+ * Link pagination), /user/orgs,
+ * POST /user/repos, POST /graphql (viewer.repositories with cursors) and
+ * GET/PATCH/DELETE /repos/{owner}/{name} on 127.0.0.1 with an ephemeral port.
+ * Repositories live in memory, so creates and deletes are visible to later
+ * listings. Options::shared adds other owners' repositories to the listings
+ * only, and Options::ordered sorts listings the way GitHub does. The server stops when the object is destroyed.
+ */
+class GitHubServer {
+public:
+    explicit GitHubServer(Options options = {}) : options_(std::move(options)), rng_(42) {
+        repos_.reserve(options_.repoCount);
+        for (size_t i = 1; i <= options_.repoCount; i++) {
+            int id = static_cast<int>(i);
+            // Same visibility and description as fixtures::repoJson renders for this id
+            addRepo({id, "repo-" + std::to_string(id), id % 4 == 0,
+                      id % 3 == 0 ? "" : "Synthetic repository number " + std::to_string(id)});
+        }
+        nextId_ = static_cast<int>(options_.repoCount) + 1;
+        for (const auto& [owner, name] : options_.shared) {
+            int id = nextId_++;
+            shared_.push_back({id, name, id % 4 == 0,
+                               id % 3 == 0 ? "" : "Synthetic repository number " + std::to_string(id), owner});
+        }
+
+        size_t threads = options_.threads;
+        server_.new_task_queue = [threads]() { return new httplib::ThreadPool(threads); };
+        server_.set_pre_routing_handler([this](const httplib::Request& req, httplib::Response& res) {
+            return admit(req, res);
+        });
+        routes();
+
+        port_ = server_.bind_to_any_port("127.0.0.1");
+        thread_ = std::thread([this]() { server_.listen_after_bind(); });
+        server_.wait_until_ready();
+    }
+
+    ~GitHubServer() {
+        server_.stop();
+        if (thread_.joinable()) thread_.join();
+    }
+
+    GitHubServer(const GitHubServer&) = delete;
+    GitHubServer& operator=(const GitHubServer&) = delete;
+
+    std::string baseUrl() const { return "http://127.0.0.1:" + std::to_string(port_); }
+    const std::string& token() const { return options_.token; }
+
+    size_t repoCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return repos_.size();
+    }
+
+    size_t requests() const { return requests_; }
+    size_t injectedErrors() const { return injectedErrors_; }
+
+private:
+    struct Repo {
+        int id;
+        std::string name;
+        bool isPrivate;
+        std::string description;
+        std::string owner;  // Empty for the user's own
+    };
+
+    static std::string lower(std::string s) {
+        std::transform(s.begin(), s.end(), s.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return s;
+    }
+
+    static void json(httplib::Response& res, int status, const std::string& body) {
+        res.status = status;
+        res.set_content(body, "application/json");
+    }
+
+    void addRepo(Repo repo) {
+        byName_[lower(repo.name)] = repos_.size();
+        repos_.push_back(std::move(repo));
+    }
+
+    // Swap-and-pop: listing order is not stable across deletes, which the client does not rely on
+    void removeRepo(size_t index) {
+        byName_.erase(lower(repos_[index].name));
+        if (index + 1 != repos_.size()) {
+            repos_[index] = std::move(repos_.back());
+            byName_[lower(repos_[index].name)] = index;
+        }
+        repos_.pop_back();
+    }
+
+    const std::string& ownerOf(const Repo& repo) const {
+        return repo.owner.empty() ? options_.login : repo.owner;
+    }
+
+    std::string restJson(const Repo& repo) const {
+        return fixtures::repoJson(ownerOf(repo), repo.id, repo.isPrivate, repo.name);
+    }
+
+    /**
+     * @brief The user's repositories, then the shared ones, sorted by full
+     *        name or by name alone if Options::ordered; call with mutex_ held
+     */
+    std::vector<const Repo*> listing(bool byFullName) const {
+        std::vector<const Repo*> out;
+        out.reserve(repos_.size() + shared_.size());
+        for (const auto& repo : repos_) out.push_back(&repo);
+        for (const auto& repo : shared_) out.push_back(&repo);
+        if (options_.ordered) {
+            auto key = [this, byFullName](const Repo* repo) {
+                return lower(byFullName ? ownerOf(*repo) + "/" + repo->name : repo->name);
+            };
+            std::stable_sort(out.begin(), out.end(),
+                             [&key](const Repo* a, const Repo* b) { return key(a) < key(b); });
+        }
+        return out;
+    }
+
+    /**
+     * @brief Answers one page of a listing of count items, with a Link header
+     *        like GitHub's; render(i) returns item i as JSON
+     */
+    template <typename Render>
+    void paginate(const httplib::Request& req, httplib::Response& res, size_t count, Render render) const {
+        size_t perPage = 30;
+        size_t page = 1;
+        if (req.has_param("per_page")) perPage = std::clamp<size_t>(std::stoul(req.get_param_value("per_page")), 1, 100);
+        if (req.has_param("page")) page = std::max<size_t>(1, std::stoul(req.get_param_value("page")));
+
+        std::string body = "[";
+        size_t lastPage = std::max<size_t>(1, (count + perPage - 1) / perPage);
+        size_t first = (page - 1) * perPage;
+        for (size_t i = first; i < std::min(count, first + perPage); i++) {
+            if (i > first) body += ",";
+            body += render(i);
+        }
+        body += "]";
+
+        if (page < lastPage) {
+            std::string base = baseUrl() + req.path + "?per_page=" + std::to_string(perPage) + "&page=";
+            res.set_header("Link", "<" + base + std::to_string(page + 1) + ">; rel=\"next\", <" +
+                                   base + std::to_string(lastPage) + ">; rel=\"last\"");
+        }
+        json(res, 200, body);
+    }
+
+    /**
+     * @brief Applies latency, error injection and the token check to every request
+     */
+    httplib::Server::HandlerResponse admit(const httplib::Request& req, httplib::Response& res) {
+        size_t seq = requests_++;
+
+        std::chrono::milliseconds delay = options_.latency;
+        bool fail = seq < options_.failFirst;
+        {
+            std::lock_guard<std::mutex> lock(rngMutex_);
+            if (options_.jitter.count() > 0) {
+                delay += std::chrono::milliseconds(
+                    std::uniform_int_distribution<long long>(0, options_.jitter.count())(rng_));
+            }
+            if (!fail && options_.errorRate > 0) {
+                fail = std::uniform_real_distribution<double>(0, 1)(rng_) < options_.errorRate;
+            }
+        }
+        if (delay.count() > 0) {
+            std::this_thread::sleep_for(delay);
+        }
+
+        if (fail) {
+            injectedErrors_++;
+            json(res, options_.errorStatus, R"({"message":"Injected failure"})");
+            return httplib::Server::HandlerResponse::Handled;
+        }
+        if (req.get_header_value("Authorization") != "Bearer " + options_.token) {
+            json(res, 401, R"({"message":"Bad credentials"})");
+            return httplib::Server::HandlerResponse::Handled;
+        }
+        return httplib::Server::HandlerResponse::Unhandled;
+    }
+
+    void routes() {
+        server_.Get("/user", [this](const httplib::Request&, httplib::Response& res) {
+            res.set_header("X-OAuth-Scopes", options_.scopes);
+            json(res, 200, nlohmann::json{{"login", options_.login}, {"id", 4242}}.dump());
+        });
+
+        server_.Get("/rate_limit", [](const httplib::Request&, httplib::Response& res) {
+            res.set_header("X-RateLimit-Limit", "5000");
+            res.set_header("X-RateLimit-Remaining", "5000");
+            res.set_header("X-RateLimit-Resource", "core");
+            json(res, 200, R"({"resources":{}})");
+        });
+
+        server_.Get("/user/repos", [this](const httplib::Request& req, httplib::Response& res) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!options_.ordered && shared_.empty()) {
+                paginate(req, res, repos_.size(), [this](size_t i) { return restJson(repos_[i]); });
+                return;
+            }
+            auto repos = listing(/*byFullName=*/true);
+            paginate(req, res, repos.size(), [this, &repos](size_t i) { return restJson(*repos[i]); });
+        });
+
+        server_.Get("/user/orgs", [this](const httplib::Request&, httplib::Response& res) {
+            nlohmann::json orgs = nlohmann::json::array();
+            for (const auto& org : options_.orgs) {
+                orgs.push_back({{"login", org.first}, {"id", 9000 + orgs.size()}});
+            }
+            json(res, 200, orgs.dump());
+        });
+
+        // Organization repositories are fixed: "repo-1" .. "repo-N" owned by the organization
+        server_.Get("/orgs/:org/repos", [this](const httplib::Request& req, httplib::Response& res) {
+            const std::string& org = req.path_params.at("org");
+            auto it = std::find_if(options_.orgs.begin(), options_.orgs.end(),
+                                   [&org](const auto& o) { return o.first == org; });
+            if (it == options_.orgs.end()) {
+                json(res, 404, R"({"message":"Not Found"})");
+                return;
+            }
+            paginate(req, res, it->second, [&org](size_t i) {
+                int id = static_cast<int>(i) + 1;
+                return fixtures::repoJson(org, id, id % 4 == 0);
+            });
+        });
+
+        server_.Post("/user/repos", [this](const httplib::Request& req, httplib::Response& res) {
+            auto data = nlohmann::json::parse(req.body, nullptr, false);
+            if (!data.is_object() || !data.contains("name") || !data["name"].is_string()) {
+                json(res, 422, R"({"message":"Validation Failed"})");
+                return;
+            }
+            Repo repo{0, data["name"].get<std::string>(), data.value("private", false),
+                      data.value("description", std::string())};
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (byName_.count(lower(repo.name))) {
+                json(res, 422, R"({"message":"Repository creation failed.","errors":[{"message":"name already exists on this account"}]})");
+                return;
+            }
+            repo.id = nextId_++;
+            addRepo(repo);
+            json(res, 201, restJson(repo));
+        });
+
+        server_.Post("/graphql", [this](const httplib::Request& req, httplib::Response& res) {
+            if (!options_.graphql) {
+                json(res, 404, R"({"message":"Not Found"})");
+                return;
+            }
+            auto data = nlohmann::json::parse(req.body, nullptr, false);
+            size_t offset = 0;
+            if (data.is_object() && data.contains("variables") && data["variables"].contains("cursor") &&
+                data["variables"]["cursor"].is_string()) {
+                offset = std::stoul(data["variables"]["cursor"].get<std::string>());
+            }
+
+            nlohmann::json nodes = nlohmann::json::array();
+            bool hasNext;
+            size_t end;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto repos = listing(/*byFullName=*/false);
+                end = std::min(repos.size(), offset + 100);
+                for (size_t i = offset; i < end; i++) {
+                    const Repo& repo = *repos[i];
+                    std::string full = ownerOf(repo) + "/" + repo.name;
+                    nodes.push_back({
+                        {"name", repo.name},
+                        {"description", repo.description.empty() ? nlohmann::json(nullptr) : nlohmann::json(repo.description)},
+                        {"isPrivate", repo.isPrivate},
+                        {"url", "https://github.com/" + full},
+                        {"sshUrl", "git@github.com:" + full + ".git"},
+                        {"updatedAt", "2026-01-" + std::to_string(10 + repo.id % 18) + "T12:00:00Z"}
+                    });
+                }
+                hasNext = end < repos.size();
+            }
+            nlohmann::json page = {
+                {"data", {{"viewer", {{"repositories", {
+                    {"pageInfo", {{"hasNextPage", hasNext}, {"endCursor", std::to_string(end)}}},
+                    {"nodes", std::move(nodes)}
+                }}}}}}
+            };
+            json(res, 200, page.dump());
+        });
+
+        server_.Get("/repos/:owner/:name", [this](const httplib::Request& req, httplib::Response& res) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = byName_.find(lower(req.path_params.at("name")));
+            if (req.path_params.at("owner") != options_.login || it == byName_.end()) {
+                json(res, 404, R"({"message":"Not Found"})");
+                return;
+            }
+            json(res, 200, restJson(repos_[it->second]));
+        });
+
+        server_.Patch("/repos/:owner/:name", [this](const httplib::Request& req, httplib::Response& res) {
+            auto data = nlohmann::json::parse(req.body, nullptr, false);
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = byName_.find(lower(req.path_params.at("name")));
+            if (req.path_params.at("owner") != options_.login || it == byName_.end() || !data.is_object()) {
+                json(res, 404, R"({"message":"Not Found"})");
+                return;
+            }
+            Repo& repo = repos_[it->second];
+            if (data.contains("private")) repo.isPrivate = data["private"].get<bool>();
+            if (data.contains("description")) repo.description = data["description"].get<std::string>();
+            json(res, 200, restJson(repo));
+        });
+
+        server_.Delete("/repos/:owner/:name", [this](const httplib::Request& req, httplib::Response& res) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = byName_.find(lower(req.path_params.at("name")));
+            if (req.path_params.at("owner") != options_.login || it == byName_.end()) {
+                json(res, 404, R"({"message":"Not Found"})");
+                return;
+            }
+            removeRepo(it->second);
+            res.status = 204;
+        });
+    }
+
+    Options options_;
+    httplib::Server server_;
+    std::thread thread_;
+    int port_ = 0;
+
+    mutable std::mutex mutex_;
+    std::vector<Repo> repos_;
+    std::vector<Repo> shared_;  // Listed only; not reachable through /repos/{owner}/{name}
+    std::unordered_map<std::string, size_t> byName_;
+    int nextId_ = 1;
+
+    std::mutex rngMutex_;
+    std::mt19937 rng_;
+    std::atomic<size_t> requests_{0};
+    std::atomic<size_t> injectedErrors_{0};
+};
+
+}  // namespace mock
+
+#endif